@@ -49,7 +49,9 @@ prte_class_t prte_object_t_class = {
     0,                    /* class hierarchy depth */
     NULL,                 /* array of constructors */
     NULL,                 /* array of destructors */
-    sizeof(prte_object_t) /* size of the prte object */
+    sizeof(prte_object_t), /* size of the prte object */
+    NULL,                 /* allocator */
+    NULL                  /* release */
 };
 
 int prte_class_init_epoch = 1;
@@ -139,6 +139,8 @@ typedef struct prte_object_t prte_object_t;
 typedef struct prte_class_t prte_class_t;
 typedef void (*prte_construct_t) (prte_object_t *);
 typedef void (*prte_destruct_t) (prte_object_t *);
+typedef void *(*prte_alloc_t) (prte_class_t *);
+typedef void (*prte_free_t) (prte_object_t *);
 
 
 /* types **************************************************************/
@@ -161,6 +163,9 @@ struct prte_class_t {
     prte_destruct_t *cls_destruct_array;
                                     /**< array of parent class destructors */
     size_t cls_sizeof;              /**< size of an object instance */
+    prte_alloc_t cls_alloc;         /**< allocator for instances of this
+                                         exact class (malloc if NULL) */
+    prte_free_t cls_free;           /**< releases storage from cls_alloc */
 };
 
 PRTE_EXPORT extern int prte_class_init_epoch;
@@ -235,7 +240,26 @@ struct prte_object_t {
         (prte_construct_t) CONSTRUCTOR,                                 \
         (prte_destruct_t) DESTRUCTOR,                                   \
         0, 0, NULL, NULL,                                               \
-        sizeof(NAME)                                                    \
+        sizeof(NAME),                                                   \
+        NULL, NULL                                                      \
+    }
+
+/**
+ * Static initializer for a class descriptor whose instances are
+ * obtained from a custom allocator rather than malloc - for classes
+ * that are created in very large numbers. The allocator is only used
+ * by PRTE_NEW of this exact class, not of classes derived from it.
+ */
+#define PRTE_CLASS_INSTANCE_ALLOC(NAME, PARENT, CONSTRUCTOR, DESTRUCTOR, ALLOC, FREE) \
+    prte_class_t NAME ## _class = {                                     \
+        # NAME,                                                         \
+        PRTE_CLASS(PARENT),                                              \
+        (prte_construct_t) CONSTRUCTOR,                                 \
+        (prte_destruct_t) DESTRUCTOR,                                   \
+        0, 0, NULL, NULL,                                               \
+        sizeof(NAME),                                                   \
+        (prte_alloc_t) ALLOC,                                           \
+        (prte_free_t) FREE                                              \
     }
 
 
@@ -331,7 +355,7 @@ static inline prte_object_t *prte_obj_new_debug(prte_class_t* type, const char*
             PRTE_SET_MAGIC_ID((object), 0);                              \
             prte_obj_run_destructors((prte_object_t *) (object));       \
             PRTE_REMEMBER_FILE_AND_LINENO( object, __FILE__, __LINE__ ); \
-            free(object);                                               \
+            prte_obj_free((prte_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -340,7 +364,7 @@ static inline prte_object_t *prte_obj_new_debug(prte_class_t* type, const char*
     do {                                                                \
         if (0 == prte_obj_update((prte_object_t *) (object), -1)) {     \
             prte_obj_run_destructors((prte_object_t *) (object));       \
-            free(object);                                               \
+            prte_obj_free((prte_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -481,7 +505,11 @@ static inline prte_object_t *prte_obj_new(prte_class_t * cls)
     prte_object_t *object;
     assert(cls->cls_sizeof >= sizeof(prte_object_t));
 
-    object = (prte_object_t *) malloc(cls->cls_sizeof);
+    if (NULL == cls->cls_alloc) {
+        object = (prte_object_t *) malloc(cls->cls_sizeof);
+    } else {
+        object = (prte_object_t *) cls->cls_alloc(cls);
+    }
     if (prte_class_init_epoch != cls->cls_initialized) {
         prte_class_initialize(cls);
     }
@@ -494,6 +522,23 @@ static inline prte_object_t *prte_obj_new(prte_class_t * cls)
 }
 
 
+/**
+ * Release the storage of an object whose destructors have been run.
+ *
+ * Do not use this function directly: use PRTE_RELEASE() instead.
+ *
+ * @param object        Pointer to the object
+ */
+static inline void prte_obj_free(prte_object_t *object)
+{
+    if (NULL == object->obj_class->cls_free) {
+        free(object);
+    } else {
+        object->obj_class->cls_free(object);
+    }
+}
+
+
 /**
  * Atomically update the object's reference count by some increment.
  *
@@ -315,7 +315,7 @@ PRTE_EXPORT int prte_hwloc_base_set_topology(char *topofile);
 
 PRTE_EXPORT hwloc_cpuset_t prte_hwloc_base_generate_cpuset(hwloc_topology_t topo,
                                                              bool use_hwthread_cpus,
-                                                             char *cpulist);
+                                                             const char *cpulist);
 
 PRTE_EXPORT int prte_hwloc_base_filter_cpus(hwloc_topology_t topo);
 
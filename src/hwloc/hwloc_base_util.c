@@ -108,7 +108,7 @@ hwloc_obj_t prte_hwloc_base_get_pu(hwloc_topology_t topo,
 
 hwloc_cpuset_t prte_hwloc_base_generate_cpuset(hwloc_topology_t topo,
                                                 bool use_hwthread_cpus,
-                                                char *cpulist)
+                                                const char *cpulist)
 {
     hwloc_cpuset_t avail = NULL, pucpus, res;
     char **ranges=NULL, **range=NULL;
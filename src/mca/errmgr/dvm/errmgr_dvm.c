@@ -52,6 +52,7 @@
 
 #include "src/util/error_strings.h"
 #include "src/util/name_fns.h"
+#include "src/util/nidmap.h"
 #include "src/util/proc_info.h"
 #include "src/util/show_help.h"
 #include "src/threads/threads.h"
@@ -411,6 +412,11 @@ static void proc_errors(int fd, short args, void *cbdata)
         PRTE_FLAG_UNSET(pptr, PRTE_PROC_FLAG_ALIVE);
         /* update the state */
         pptr->state = state;
+        /* the node is no longer usable */
+        if (NULL != pptr->node) {
+            pptr->node->state = PRTE_NODE_STATE_DOWN;
+            prte_util_nidmap_record(pptr->node, PRTE_NIDMAP_UPDATE);
+        }
         /* adjust our num_procs */
         --prte_process_info.num_daemons;
         /* if we have ordered orteds to terminate or abort
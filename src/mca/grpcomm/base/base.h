@@ -37,6 +37,7 @@
 #include "src/dss/dss_types.h"
 #include "src/mca/base/prte_mca_base_framework.h"
 #include "src/hwloc/hwloc-internal.h"
+#include "src/event/event-internal.h"
 
 #include "src/mca/mca.h"
 #include "src/mca/odls/odls_types.h"
@@ -72,9 +73,27 @@ PRTE_CLASS_DECLARATION(prte_grpcomm_base_active_t);
 typedef struct {
     prte_list_t actives;
     prte_list_t ongoing;
+    /* ongoing trackers indexed by signature hash - trackers
+     * whose hash collides with an indexed one are counted
+     * in nunindexed and found by searching the list */
+    prte_hash_table_t coll_table;
+    size_t nunindexed;
+    /* trackers older than this (in seconds) are reclaimed */
+    int coll_timeout;
+    prte_event_t reaper;
+    bool reaper_active;
+    /* signatures of recently reclaimed trackers, so that
+     * contributions arriving late are not mistaken for
+     * the start of a new collective */
+    prte_list_t reaped;
+    /* tracker lookup statistics - only some lookups are timed */
+    size_t nlookups;
+    size_t ntimed;
+    double lookup_time;
     prte_hash_table_t sig_table;
     char *transports;
     size_t context_id;
+    bool fence_dedup;
 } prte_grpcomm_base_t;
 
 PRTE_EXPORT extern prte_grpcomm_base_t prte_grpcomm_base;
@@ -95,8 +114,53 @@ PRTE_EXPORT int prte_grpcomm_API_rbcast(prte_grpcomm_signature_t *sig,
 PRTE_EXPORT int prte_grpcomm_API_register_cb(prte_grpcomm_rbcast_cb_t callback);
 
 PRTE_EXPORT prte_grpcomm_coll_t* prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig, bool create);
+/* number of ongoing collectives and the mean time (in usec) taken
+ * to look up their trackers */
+PRTE_EXPORT void prte_grpcomm_base_tracker_stats(size_t *ntrackers, double *lookup_usec);
 PRTE_EXPORT void prte_grpcomm_base_mark_distance_recv(prte_grpcomm_coll_t *coll, uint32_t distance);
 PRTE_EXPORT unsigned int prte_grpcomm_base_check_distance_recv(prte_grpcomm_coll_t *coll, uint32_t distance);
 
+/* Rootless allgather exchange shared by the components that need no
+ * daemon to act as a root. In round k, each daemon sends the first
+ * nblocks of the contributions it holds to a single peer, and stores
+ * the blocks it receives in round k in slots [2^k, 2^k + nblocks)
+ * of coll->buffers - so rounds can be received in any order. Slot 0
+ * holds our own contribution. The components only say who the peer
+ * of each round is and which rank's contribution ends up in a slot */
+typedef size_t (*prte_grpcomm_base_exchange_peer_fn_t)(prte_grpcomm_coll_t *coll, uint32_t round);
+typedef int32_t (*prte_grpcomm_base_exchange_nblocks_fn_t)(prte_grpcomm_coll_t *coll, uint32_t round);
+typedef size_t (*prte_grpcomm_base_exchange_slot_fn_t)(prte_grpcomm_coll_t *coll, size_t rank);
+
+typedef struct {
+    /* name of the component, for output */
+    const char *name;
+    /* tag the rounds are exchanged on */
+    prte_rml_tag_t tag;
+    /* rank of the daemon we send to in the given round */
+    prte_grpcomm_base_exchange_peer_fn_t peer;
+    /* number of blocks sent in the given round */
+    prte_grpcomm_base_exchange_nblocks_fn_t nblocks;
+    /* slot holding the contribution of the given rank
+     * once the exchange is complete */
+    prte_grpcomm_base_exchange_slot_fn_t slot;
+    /* rounds for the next instance of a collective
+     * that is still in progress here */
+    prte_list_t pending;
+} prte_grpcomm_base_exchange_t;
+
+PRTE_EXPORT void prte_grpcomm_base_exchange_init(prte_grpcomm_base_exchange_t *ex);
+PRTE_EXPORT void prte_grpcomm_base_exchange_finalize(prte_grpcomm_base_exchange_t *ex);
+PRTE_EXPORT int prte_grpcomm_base_exchange_allgather(prte_grpcomm_base_exchange_t *ex,
+                                                      prte_grpcomm_coll_t *coll,
+                                                      prte_buffer_t *buf, int mode);
+/* the components built on the exchange only differ in their module,
+ * their default priority and the name of their algorithm, so they
+ * share the registration of their params and their query */
+PRTE_EXPORT int prte_grpcomm_base_exchange_register(prte_mca_base_component_t *c,
+                                                     const char *algorithm,
+                                                     int *priority, int *min_daemons);
+PRTE_EXPORT int prte_grpcomm_base_exchange_query(prte_grpcomm_base_module_t *mod, int priority,
+                                                  prte_mca_base_module_t **module, int *pri);
+
 END_C_DECLS
 #endif
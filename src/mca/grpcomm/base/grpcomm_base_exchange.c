@@ -0,0 +1,469 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2014-2020 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "src/dss/dss.h"
+#include "src/class/prte_list.h"
+#include "src/class/prte_hash_table.h"
+
+#include "src/mca/base/prte_mca_base_var.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/rml/rml.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+
+#include "src/mca/grpcomm/base/base.h"
+
+/* a round for the next instance of a collective
+ * that is still in progress here */
+typedef struct {
+    prte_list_item_t super;
+    prte_process_name_t sender;
+    prte_buffer_t *buffer;
+} exchange_pending_t;
+static void pcon(exchange_pending_t *p)
+{
+    p->buffer = NULL;
+}
+static void pdes(exchange_pending_t *p)
+{
+    if (NULL != p->buffer) {
+        PRTE_RELEASE(p->buffer);
+    }
+}
+static PRTE_CLASS_INSTANCE(exchange_pending_t,
+                           prte_list_item_t,
+                           pcon, pdes);
+
+static void exchange_recv(int status, prte_process_name_t* sender,
+                          prte_buffer_t* buffer, prte_rml_tag_t tag,
+                          void* cbdata);
+
+int prte_grpcomm_base_exchange_register(prte_mca_base_component_t *c,
+                                        const char *algorithm,
+                                        int *priority, int *min_daemons)
+{
+    char *desc;
+
+    if (0 > asprintf(&desc, "Priority of the grpcomm %s component (below direct by default - "
+                     "raise it above direct to use %s for large allgathers)",
+                     c->mca_component_name, algorithm)) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    (void) prte_mca_base_component_var_register(c, "priority", desc,
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           priority);
+    free(desc);
+
+    if (0 > asprintf(&desc, "Minimum number of participating daemons for an allgather "
+                     "to use %s instead of the next grpcomm component", algorithm)) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    (void) prte_mca_base_component_var_register(c, "min_daemons", desc,
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           min_daemons);
+    free(desc);
+    return PRTE_SUCCESS;
+}
+
+int prte_grpcomm_base_exchange_query(prte_grpcomm_base_module_t *mod, int priority,
+                                     prte_mca_base_module_t **module, int *pri)
+{
+    /* we are always available - the module declines
+     * the collectives it cannot handle */
+    *pri = priority;
+    *module = (prte_mca_base_module_t *)mod;
+    return PRTE_SUCCESS;
+}
+
+void prte_grpcomm_base_exchange_init(prte_grpcomm_base_exchange_t *ex)
+{
+    PRTE_CONSTRUCT(&ex->pending, prte_list_t);
+
+    /* post the receive */
+    prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD, ex->tag,
+                            PRTE_RML_PERSISTENT,
+                            exchange_recv, ex);
+}
+
+void prte_grpcomm_base_exchange_finalize(prte_grpcomm_base_exchange_t *ex)
+{
+    /* cancel the recv */
+    prte_rml.recv_cancel(PRTE_NAME_WILDCARD, ex->tag);
+    PRTE_LIST_DESTRUCT(&ex->pending);
+}
+
+static uint32_t exchange_nrounds(prte_grpcomm_coll_t *coll)
+{
+    uint32_t nrounds = 0;
+    size_t d;
+
+    for (d=1; d < coll->ndmns; d <<= 1) {
+        ++nrounds;
+    }
+    return nrounds;
+}
+
+/* the vpid of the daemon holding the given rank in the collective */
+static prte_vpid_t exchange_vpid(prte_grpcomm_coll_t *coll, size_t rank)
+{
+    if (NULL == coll->dmns) {
+        return (prte_vpid_t)rank;
+    }
+    return coll->dmns[rank];
+}
+
+/* FNV-1a hash of a block */
+static uint64_t block_hash(const uint8_t *bytes, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    size_t n;
+
+    for (n=0; n < size; n++) {
+        hash ^= bytes[n];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* prepare the tracker for the exchange */
+static int exchange_setup(prte_grpcomm_coll_t *coll)
+{
+    size_t n;
+
+    if (NULL != coll->buffers) {
+        /* already done */
+        return PRTE_SUCCESS;
+    }
+    if (NULL == coll->dmns) {
+        /* all daemons are participating */
+        coll->my_rank = PRTE_PROC_MY_NAME->vpid;
+    } else {
+        for (n=0; n < coll->ndmns; n++) {
+            if (coll->dmns[n] == PRTE_PROC_MY_NAME->vpid) {
+                break;
+            }
+        }
+        if (n == coll->ndmns) {
+            return PRTE_ERR_NOT_FOUND;
+        }
+        coll->my_rank = n;
+    }
+    coll->buffers = (prte_buffer_t**)calloc(coll->ndmns, sizeof(prte_buffer_t*));
+    if (NULL == coll->buffers) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    prte_bitmap_init(&coll->distance_mask_recv, exchange_nrounds(coll) + 1);
+    coll->nexpected = coll->ndmns;
+    coll->nreported = 0;
+    coll->round = 0;
+    return PRTE_SUCCESS;
+}
+
+/* each block is preceded by the index of an identical block earlier
+ * in the same message, or by -1 if its data follows. Identical blocks
+ * are only looked for if we were asked to deduplicate, but every
+ * daemon can read either form */
+static int exchange_send_round(prte_grpcomm_base_exchange_t *ex,
+                               prte_grpcomm_coll_t *coll)
+{
+    prte_buffer_t *send_buf;
+    prte_process_name_t peer;
+    prte_byte_object_t bo, *boptr;
+    prte_hash_table_t index;
+    uint64_t hash;
+    void *ptr;
+    int32_t n, nblocks, ref;
+    int rc = PRTE_SUCCESS;
+
+    nblocks = ex->nblocks(coll, coll->round);
+    peer.jobid = PRTE_PROC_MY_NAME->jobid;
+    peer.vpid = exchange_vpid(coll, ex->peer(coll, coll->round));
+
+    PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:%s round %u sending %d blocks to %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ex->name,
+                         coll->round, nblocks, PRTE_NAME_PRINT(&peer)));
+
+    send_buf = PRTE_NEW(prte_buffer_t);
+    /* pack the signature */
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(send_buf, &coll->sig, 1, PRTE_SIGNATURE))) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(send_buf);
+        return rc;
+    }
+    /* pack the round and the number of blocks */
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(send_buf, &coll->round, 1, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(send_buf);
+        return rc;
+    }
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(send_buf, &nblocks, 1, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(send_buf);
+        return rc;
+    }
+    /* pack the blocks */
+    if (coll->dedup) {
+        PRTE_CONSTRUCT(&index, prte_hash_table_t);
+        prte_hash_table_init(&index, nblocks);
+    }
+    boptr = &bo;
+    for (n=0; n < nblocks; n++) {
+        bo.bytes = (uint8_t*)coll->buffers[n]->base_ptr;
+        bo.size = coll->buffers[n]->bytes_used;
+        ref = -1;
+        if (coll->dedup) {
+            hash = block_hash(bo.bytes, bo.size);
+            if (PRTE_SUCCESS == prte_hash_table_get_value_uint64(&index, hash, &ptr)) {
+                ref = (int32_t)(intptr_t)ptr;
+                if (coll->buffers[ref]->bytes_used != (size_t)bo.size ||
+                    (0 < bo.size && 0 != memcmp(coll->buffers[ref]->base_ptr, bo.bytes, bo.size))) {
+                    /* collision - send this one in full */
+                    ref = -1;
+                }
+            } else {
+                prte_hash_table_set_value_uint64(&index, hash, (void*)(intptr_t)n);
+            }
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(send_buf, &ref, 1, PRTE_INT32))) {
+            break;
+        }
+        if (0 > ref &&
+            PRTE_SUCCESS != (rc = prte_dss.pack(send_buf, &boptr, 1, PRTE_BYTE_OBJECT))) {
+            break;
+        }
+    }
+    if (coll->dedup) {
+        PRTE_DESTRUCT(&index);
+    }
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(send_buf);
+        return rc;
+    }
+
+    if (0 > (rc = prte_rml.send_buffer_nb(&peer, send_buf, ex->tag,
+                                          prte_rml_send_callback, NULL))) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(send_buf);
+        return rc;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* send every round we have the data for, and complete
+ * the collective once all contributions are in */
+static void exchange_progress(prte_grpcomm_base_exchange_t *ex,
+                              prte_grpcomm_coll_t *coll)
+{
+    prte_buffer_t *result;
+    prte_list_t early;
+    exchange_pending_t *p;
+    uint32_t nrounds;
+    size_t n;
+    int rc;
+
+    /* we cannot start until our own contribution is in */
+    if (NULL == coll->buffers[0]) {
+        return;
+    }
+    nrounds = exchange_nrounds(coll);
+    while (coll->round < nrounds) {
+        /* a round needs all blocks from the prior rounds */
+        if (0 < coll->round &&
+            !prte_grpcomm_base_check_distance_recv(coll, coll->round - 1)) {
+            return;
+        }
+        if (PRTE_SUCCESS != (rc = exchange_send_round(ex, coll))) {
+            PRTE_ERROR_LOG(rc);
+            return;
+        }
+        ++coll->round;
+    }
+    if (coll->nreported < coll->nexpected) {
+        return;
+    }
+
+    PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:%s allgather complete",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ex->name));
+
+    /* assemble the result in rank order, as every
+     * daemon holds the contributions in its own order */
+    result = PRTE_NEW(prte_buffer_t);
+    for (n=0; n < coll->ndmns; n++) {
+        prte_dss.copy_payload(result, coll->buffers[ex->slot(coll, n)]);
+    }
+    /* execute the callback */
+    if (NULL != coll->cbfunc) {
+        coll->cbfunc(PRTE_SUCCESS, result, coll->cbdata);
+    }
+    PRTE_RELEASE(result);
+    prte_list_remove_item(&prte_grpcomm_base.ongoing, &coll->super);
+    PRTE_RELEASE(coll);
+
+    /* anything held back may now belong to a new instance */
+    if (!prte_list_is_empty(&ex->pending)) {
+        PRTE_CONSTRUCT(&early, prte_list_t);
+        prte_list_join(&early, prte_list_get_end(&early), &ex->pending);
+        while (NULL != (p = (exchange_pending_t*)prte_list_remove_first(&early))) {
+            exchange_recv(PRTE_SUCCESS, &p->sender, p->buffer, ex->tag, ex);
+            PRTE_RELEASE(p);
+        }
+        PRTE_LIST_DESTRUCT(&early);
+    }
+}
+
+int prte_grpcomm_base_exchange_allgather(prte_grpcomm_base_exchange_t *ex,
+                                         prte_grpcomm_coll_t *coll,
+                                         prte_buffer_t *buf, int mode)
+{
+    int rc;
+
+    PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:%s: allgather",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ex->name));
+
+    if (PRTE_SUCCESS != (rc = exchange_setup(coll))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (PRTE_GRPCOMM_MODE_DEDUP & mode) {
+        coll->dedup = true;
+    }
+    /* our own contribution goes in the first slot */
+    coll->buffers[0] = PRTE_NEW(prte_buffer_t);
+    prte_dss.copy_payload(coll->buffers[0], buf);
+    coll->nreported++;
+
+    exchange_progress(ex, coll);
+    return PRTE_SUCCESS;
+}
+
+static void exchange_recv(int status, prte_process_name_t* sender,
+                          prte_buffer_t* buffer, prte_rml_tag_t tag,
+                          void* cbdata)
+{
+    prte_grpcomm_base_exchange_t *ex = (prte_grpcomm_base_exchange_t*)cbdata;
+    int32_t cnt, n, nblocks, ref;
+    int rc;
+    uint32_t round;
+    size_t first, slot;
+    prte_grpcomm_signature_t *sig;
+    prte_grpcomm_coll_t *coll;
+    prte_byte_object_t *bo;
+    exchange_pending_t *p;
+    char *start;
+
+    PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:%s allgather recvd from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ex->name,
+                         PRTE_NAME_PRINT(sender)));
+
+    start = buffer->unpack_ptr;
+
+    /* unpack the signature */
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &sig, &cnt, PRTE_SIGNATURE))) {
+        PRTE_ERROR_LOG(rc);
+        return;
+    }
+
+    /* check for the tracker and create it if not found */
+    if (NULL == (coll = prte_grpcomm_base_get_tracker(sig, true))) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        PRTE_RELEASE(sig);
+        return;
+    }
+    PRTE_RELEASE(sig);
+    if (PRTE_SUCCESS != (rc = exchange_setup(coll))) {
+        PRTE_ERROR_LOG(rc);
+        return;
+    }
+
+    /* unpack the round and the number of blocks */
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &round, &cnt, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &nblocks, &cnt, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        return;
+    }
+
+    /* each round is received once per instance of the collective,
+     * so a repeat comes from a peer that has already moved on
+     * to the next one - hold it until we finish this one */
+    if (prte_grpcomm_base_check_distance_recv(coll, round)) {
+        PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:%s holding round %u from %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ex->name,
+                             round, PRTE_NAME_PRINT(sender)));
+        p = PRTE_NEW(exchange_pending_t);
+        p->sender = *sender;
+        p->buffer = PRTE_NEW(prte_buffer_t);
+        buffer->unpack_ptr = start;
+        prte_dss.copy_payload(p->buffer, buffer);
+        prte_list_append(&ex->pending, &p->super);
+        return;
+    }
+
+    /* the blocks of round k go in the slots from 2^k */
+    first = (size_t)1 << round;
+    for (n=0, slot=first; n < nblocks; n++, slot++) {
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &ref, &cnt, PRTE_INT32))) {
+            PRTE_ERROR_LOG(rc);
+            return;
+        }
+        if (0 <= ref) {
+            /* same as an earlier block of this message */
+            if (n <= ref || coll->ndmns <= first + ref || NULL == coll->buffers[first + ref]) {
+                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+                return;
+            }
+            if (slot < coll->ndmns && NULL == coll->buffers[slot]) {
+                coll->buffers[slot] = PRTE_NEW(prte_buffer_t);
+                prte_dss.copy_payload(coll->buffers[slot], coll->buffers[first + ref]);
+                coll->nreported++;
+            }
+            continue;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &bo, &cnt, PRTE_BYTE_OBJECT))) {
+            PRTE_ERROR_LOG(rc);
+            return;
+        }
+        if (slot < coll->ndmns && NULL == coll->buffers[slot]) {
+            coll->buffers[slot] = PRTE_NEW(prte_buffer_t);
+            prte_dss.load(coll->buffers[slot], bo->bytes, bo->size);
+            coll->nreported++;
+        } else if (NULL != bo->bytes) {
+            free(bo->bytes);
+        }
+        free(bo);
+    }
+    prte_grpcomm_base_mark_distance_recv(coll, round);
+
+    exchange_progress(ex, coll);
+}
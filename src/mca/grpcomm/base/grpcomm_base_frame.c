@@ -68,6 +68,22 @@ static int base_register(prte_mca_base_register_flag_t flags)
                                 PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                 &prte_grpcomm_base.context_id);
 
+    prte_grpcomm_base.fence_dedup = false;
+    prte_mca_base_var_register("prte", "grpcomm", "base", "fence_dedup",
+                                "Send identical fence contributions only once on their way through the daemon tree (each message says which form it is in, so daemons need not agree on this setting)",
+                                PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_grpcomm_base.fence_dedup);
+
+    prte_grpcomm_base.coll_timeout = 0;
+    prte_mca_base_var_register("prte", "grpcomm", "base", "coll_timeout",
+                                "Time (in seconds) after which a collective that has not completed is abandoned and its tracker reclaimed (0 => never)",
+                                PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                PRTE_INFO_LVL_9,
+                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prte_grpcomm_base.coll_timeout);
+
     return PRTE_SUCCESS;
 }
 
@@ -91,7 +107,13 @@ static int prte_grpcomm_base_close(void)
         }
     }
     PRTE_LIST_DESTRUCT(&prte_grpcomm_base.actives);
+    if (prte_grpcomm_base.reaper_active) {
+        prte_event_evtimer_del(&prte_grpcomm_base.reaper);
+        prte_grpcomm_base.reaper_active = false;
+    }
     PRTE_LIST_DESTRUCT(&prte_grpcomm_base.ongoing);
+    PRTE_LIST_DESTRUCT(&prte_grpcomm_base.reaped);
+    PRTE_DESTRUCT(&prte_grpcomm_base.coll_table);
     for (void *_nptr=NULL;                                   \
          PRTE_SUCCESS == prte_hash_table_get_next_key_ptr(&prte_grpcomm_base.sig_table, &key, &size, (void **)&seq_number, _nptr, &_nptr);) {
         free(seq_number);
@@ -109,6 +131,14 @@ static int prte_grpcomm_base_open(prte_mca_base_open_flag_t flags)
 {
     PRTE_CONSTRUCT(&prte_grpcomm_base.actives, prte_list_t);
     PRTE_CONSTRUCT(&prte_grpcomm_base.ongoing, prte_list_t);
+    PRTE_CONSTRUCT(&prte_grpcomm_base.coll_table, prte_hash_table_t);
+    prte_hash_table_init(&prte_grpcomm_base.coll_table, 128);
+    prte_grpcomm_base.nunindexed = 0;
+    prte_grpcomm_base.reaper_active = false;
+    PRTE_CONSTRUCT(&prte_grpcomm_base.reaped, prte_list_t);
+    prte_grpcomm_base.nlookups = 0;
+    prte_grpcomm_base.ntimed = 0;
+    prte_grpcomm_base.lookup_time = 0.0;
     PRTE_CONSTRUCT(&prte_grpcomm_base.sig_table, prte_hash_table_t);
     prte_hash_table_init(&prte_grpcomm_base.sig_table, 128);
 
@@ -142,6 +172,11 @@ PRTE_CLASS_INSTANCE(prte_grpcomm_signature_t,
 static void ccon(prte_grpcomm_coll_t *p)
 {
     p->sig = NULL;
+    p->sorted = NULL;
+    p->sighash = 0;
+    p->indexed = false;
+    p->counted = false;
+    p->start = 0;
     PRTE_CONSTRUCT(&p->bucket, prte_buffer_t);
     PRTE_CONSTRUCT(&p->distance_mask_recv, prte_bitmap_t);
     p->dmns = NULL;
@@ -151,17 +186,61 @@ static void ccon(prte_grpcomm_coll_t *p)
     p->cbfunc = NULL;
     p->cbdata = NULL;
     p->buffers = NULL;
+    p->round = 0;
+    PRTE_CONSTRUCT(&p->blobs, prte_list_t);
+    PRTE_CONSTRUCT(&p->blob_index, prte_hash_table_t);
+    p->dedup = false;
 }
 static void cdes(prte_grpcomm_coll_t *p)
 {
+    size_t n;
+
+    /* remove us from the index */
+    if (p->indexed) {
+        prte_hash_table_remove_value_uint64(&prte_grpcomm_base.coll_table, p->sighash);
+    } else if (p->counted) {
+        prte_grpcomm_base.nunindexed--;
+    }
     if (NULL != p->sig) {
         PRTE_RELEASE(p->sig);
     }
+    free(p->sorted);
     PRTE_DESTRUCT(&p->bucket);
     PRTE_DESTRUCT(&p->distance_mask_recv);
+    if (NULL != p->buffers) {
+        for (n=0; n < p->ndmns; n++) {
+            if (NULL != p->buffers[n]) {
+                PRTE_RELEASE(p->buffers[n]);
+            }
+        }
+        free(p->buffers);
+    }
     free(p->dmns);
-    free(p->buffers);
+    PRTE_LIST_DESTRUCT(&p->blobs);
+    PRTE_DESTRUCT(&p->blob_index);
 }
 PRTE_CLASS_INSTANCE(prte_grpcomm_coll_t,
                    prte_list_item_t,
                    ccon, cdes);
+
+static void bcon(prte_grpcomm_blob_t *p)
+{
+    p->hash = 0;
+    p->data.size = 0;
+    p->data.bytes = NULL;
+    p->vpids = NULL;
+    p->nvpids = 0;
+    p->nalloc = 0;
+}
+static void bdes(prte_grpcomm_blob_t *p)
+{
+    if (NULL != p->data.bytes) {
+        free(p->data.bytes);
+    }
+    if (NULL != p->vpids) {
+        free(p->vpids);
+    }
+}
+PRTE_CLASS_INSTANCE(prte_grpcomm_blob_t,
+                   prte_list_item_t,
+                   bcon, bdes);
@@ -31,6 +31,9 @@
  */
 #include "prte_config.h"
 
+#include <sys/time.h>
+#include <time.h>
+#include <string.h>
 
 #include "src/dss/dss.h"
 
@@ -190,6 +193,8 @@ int prte_grpcomm_API_register_cb(prte_grpcomm_rbcast_cb_t callback)
     return rc;
 }
 
+static void reaped_forget(prte_grpcomm_signature_t *sig);
+
 static void allgather_stub(int fd, short args, void *cbdata)
 {
     prte_grpcomm_caddy_t *cd = (prte_grpcomm_caddy_t*)cbdata;
@@ -231,6 +236,7 @@ static void allgather_stub(int fd, short args, void *cbdata)
         PRTE_RELEASE(cd);
         return;
     }
+    reaped_forget(cd->sig);
     coll = prte_grpcomm_base_get_tracker(cd->sig, true);
     if (NULL == coll) {
         PRTE_RELEASE(cd->sig);
@@ -280,32 +286,262 @@ int prte_grpcomm_API_allgather(prte_grpcomm_signature_t *sig,
     return PRTE_SUCCESS;
 }
 
+/* order the procs of a signature by jobid, then vpid */
+static int sig_cmp(const void *a, const void *b)
+{
+    const prte_process_name_t *p1 = (const prte_process_name_t*)a;
+    const prte_process_name_t *p2 = (const prte_process_name_t*)b;
+
+    if (p1->jobid != p2->jobid) {
+        return (p1->jobid < p2->jobid) ? -1 : 1;
+    }
+    if (p1->vpid != p2->vpid) {
+        return (p1->vpid < p2->vpid) ? -1 : 1;
+    }
+    return 0;
+}
+
+/* a sorted copy of the procs in a signature, so that callers
+ * listing the same procs in a different order find the same
+ * collective */
+static prte_process_name_t* sig_sort(prte_grpcomm_signature_t *sig)
+{
+    prte_process_name_t *procs;
+
+    if (NULL == sig->signature || 0 == sig->sz) {
+        return NULL;
+    }
+    procs = (prte_process_name_t*)malloc(sig->sz * sizeof(prte_process_name_t));
+    if (NULL == procs) {
+        return NULL;
+    }
+    memcpy(procs, sig->signature, sig->sz * sizeof(prte_process_name_t));
+    qsort(procs, sig->sz, sizeof(prte_process_name_t), sig_cmp);
+    return procs;
+}
+
+/* FNV-1a hash of the sorted procs in a signature */
+static uint64_t sig_hash(prte_process_name_t *procs, size_t sz)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const uint8_t *bytes;
+    size_t n;
+
+    if (NULL == procs) {
+        return hash;
+    }
+    bytes = (const uint8_t*)procs;
+    sz *= sizeof(prte_process_name_t);
+    for (n=0; n < sz; n++) {
+        hash ^= bytes[n];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool sig_match(prte_process_name_t *procs, size_t sz, prte_grpcomm_coll_t *coll)
+{
+    if (NULL == procs || NULL == coll->sorted) {
+        /* only one collective can operate at a time
+         * across every process in the system */
+        return (procs == coll->sorted);
+    }
+    if (sz != coll->sig->sz) {
+        return false;
+    }
+    return (0 == memcmp(procs, coll->sorted, sz * sizeof(prte_process_name_t)));
+}
+
+/* a reclaimed collective that may still receive
+ * contributions from the daemons that were late */
+typedef struct {
+    prte_list_item_t super;
+    prte_process_name_t *sorted;
+    size_t sz;
+    uint64_t sighash;
+    size_t remaining;
+    time_t when;
+} reaped_t;
+static void rpcon(reaped_t *p)
+{
+    p->sorted = NULL;
+    p->sz = 0;
+    p->remaining = 0;
+}
+static void rpdes(reaped_t *p)
+{
+    if (NULL != p->sorted) {
+        free(p->sorted);
+    }
+}
+static PRTE_CLASS_INSTANCE(reaped_t,
+                           prte_list_item_t,
+                           rpcon, rpdes);
+
+/* only the most recently reclaimed collectives are remembered */
+#define PRTE_GRPCOMM_BASE_MAX_REAPED 64
+
+static void reaped_add(prte_grpcomm_coll_t *coll, time_t now)
+{
+    reaped_t *rp;
+
+    if (coll->nreported >= coll->nexpected) {
+        /* nobody is left to report */
+        return;
+    }
+    if (PRTE_GRPCOMM_BASE_MAX_REAPED <= prte_list_get_size(&prte_grpcomm_base.reaped)) {
+        rp = (reaped_t*)prte_list_remove_first(&prte_grpcomm_base.reaped);
+        PRTE_RELEASE(rp);
+    }
+    rp = PRTE_NEW(reaped_t);
+    rp->sorted = coll->sorted;
+    coll->sorted = NULL;
+    rp->sz = (NULL == coll->sig) ? 0 : coll->sig->sz;
+    rp->sighash = coll->sighash;
+    rp->remaining = coll->nexpected - coll->nreported;
+    rp->when = now;
+    prte_list_append(&prte_grpcomm_base.reaped, &rp->super);
+}
+
+static reaped_t* reaped_find(prte_process_name_t *procs, size_t sz, uint64_t hash)
+{
+    reaped_t *rp;
+
+    PRTE_LIST_FOREACH(rp, &prte_grpcomm_base.reaped, reaped_t) {
+        if (rp->sighash != hash || rp->sz != sz) {
+            continue;
+        }
+        if (NULL == procs || NULL == rp->sorted) {
+            if (procs == rp->sorted) {
+                return rp;
+            }
+        } else if (0 == memcmp(procs, rp->sorted, sz * sizeof(prte_process_name_t))) {
+            return rp;
+        }
+    }
+    return NULL;
+}
+
+/* we are starting a new collective across these procs, so
+ * anything that arrives for them belongs to it */
+static void reaped_forget(prte_grpcomm_signature_t *sig)
+{
+    prte_process_name_t *sorted;
+    reaped_t *rp;
+
+    if (prte_list_is_empty(&prte_grpcomm_base.reaped)) {
+        return;
+    }
+    sorted = sig_sort(sig);
+    if (NULL != (rp = reaped_find(sorted, sig->sz, sig_hash(sorted, sig->sz)))) {
+        prte_list_remove_item(&prte_grpcomm_base.reaped, &rp->super);
+        PRTE_RELEASE(rp);
+    }
+    free(sorted);
+}
+
+/* abandon any collective that has been running for too long */
+static void reap_trackers(int fd, short args, void *cbdata)
+{
+    prte_grpcomm_coll_t *coll, *next;
+    prte_buffer_t buf;
+    struct timeval tv;
+    time_t now;
+
+    prte_grpcomm_base.reaper_active = false;
+    now = time(NULL);
+    PRTE_LIST_FOREACH_SAFE(coll, next, &prte_grpcomm_base.ongoing, prte_grpcomm_coll_t) {
+        if (now - coll->start < prte_grpcomm_base.coll_timeout) {
+            continue;
+        }
+        PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:base: reclaiming tracker after %ld seconds with %lu of %lu reported",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (long)(now - coll->start),
+                             (unsigned long)coll->nreported, (unsigned long)coll->nexpected));
+        prte_list_remove_item(&prte_grpcomm_base.ongoing, &coll->super);
+        reaped_add(coll, now);
+        if (NULL != coll->cbfunc) {
+            PRTE_CONSTRUCT(&buf, prte_buffer_t);
+            coll->cbfunc(PRTE_ERR_TIMEOUT, &buf, coll->cbdata);
+            PRTE_DESTRUCT(&buf);
+        }
+        PRTE_RELEASE(coll);
+    }
+    if (!prte_list_is_empty(&prte_grpcomm_base.ongoing)) {
+        tv.tv_sec = prte_grpcomm_base.coll_timeout;
+        tv.tv_usec = 0;
+        prte_event_evtimer_add(&prte_grpcomm_base.reaper, &tv);
+        prte_grpcomm_base.reaper_active = true;
+    }
+}
+
+void prte_grpcomm_base_tracker_stats(size_t *ntrackers, double *lookup_usec)
+{
+    *ntrackers = prte_list_get_size(&prte_grpcomm_base.ongoing);
+    if (0 == prte_grpcomm_base.ntimed) {
+        *lookup_usec = 0.0;
+    } else {
+        *lookup_usec = prte_grpcomm_base.lookup_time / (double)prte_grpcomm_base.ntimed;
+    }
+}
+
 prte_grpcomm_coll_t* prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig, bool create)
 {
-    prte_grpcomm_coll_t *coll;
+    prte_grpcomm_coll_t *coll, *cptr;
     int rc;
     prte_namelist_t *nm;
     prte_list_t children;
+    prte_process_name_t *sorted;
     size_t n;
+    uint64_t hash;
+    struct timeval start, end;
+    reaped_t *rp;
+    time_t now;
+    bool timed;
+
+    /* the clock is only read for a sample of the lookups */
+    timed = (0 == (prte_grpcomm_base.nlookups++ % 64));
+    if (timed) {
+        gettimeofday(&start, NULL);
+    }
 
-    /* search the existing tracker list to see if this already exists */
-    PRTE_LIST_FOREACH(coll, &prte_grpcomm_base.ongoing, prte_grpcomm_coll_t) {
-        if (NULL == sig->signature) {
-            if (NULL == coll->sig->signature) {
-                /* only one collective can operate at a time
-                 * across every process in the system */
-                return coll;
+    sorted = sig_sort(sig);
+    if (NULL == sorted && NULL != sig->signature && 0 < sig->sz) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return NULL;
+    }
+
+    /* look for the tracker in the index */
+    hash = sig_hash(sorted, sig->sz);
+    coll = NULL;
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint64(&prte_grpcomm_base.coll_table,
+                                                          hash, (void**)&cptr) &&
+        sig_match(sorted, sig->sz, cptr)) {
+        coll = cptr;
+    } else if (0 < prte_grpcomm_base.nunindexed) {
+        /* it may have collided with one that is */
+        PRTE_LIST_FOREACH(cptr, &prte_grpcomm_base.ongoing, prte_grpcomm_coll_t) {
+            if (!cptr->indexed && sig_match(sorted, sig->sz, cptr)) {
+                coll = cptr;
+                break;
             }
-            /* if only one is NULL, then we can't possibly match */
-            break;
-        }
-        if (PRTE_EQUAL == (rc = prte_dss.compare(sig, coll->sig, PRTE_SIGNATURE))) {
-            PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:base:returning existing collective",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-            return coll;
         }
     }
+
+    if (timed) {
+        gettimeofday(&end, NULL);
+        prte_grpcomm_base.ntimed++;
+        prte_grpcomm_base.lookup_time += (double)(end.tv_sec - start.tv_sec) * 1000000.0 +
+                                         (double)(end.tv_usec - start.tv_usec);
+    }
+
+    if (NULL != coll) {
+        PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:base:returning existing collective",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+        free(sorted);
+        return coll;
+    }
     /* if we get here, then this is a new collective - so create
      * the tracker for it */
     if (!create) {
@@ -313,10 +549,33 @@ prte_grpcomm_coll_t* prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig
                              "%s grpcomm:base: not creating new coll",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
 
+        free(sorted);
         return NULL;
     }
+    /* a contribution to a collective we already gave up on must
+     * not start a new one that nobody else will complete */
+    now = time(NULL);
+    if (NULL != (rp = reaped_find(sorted, sig->sz, hash))) {
+        if (now - rp->when < prte_grpcomm_base.coll_timeout) {
+            PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                                 "%s grpcomm:base: dropping late contribution to a reclaimed collective",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+            if (0 == --rp->remaining) {
+                prte_list_remove_item(&prte_grpcomm_base.reaped, &rp->super);
+                PRTE_RELEASE(rp);
+            }
+            free(sorted);
+            return NULL;
+        }
+        /* too old to still be a straggler */
+        prte_list_remove_item(&prte_grpcomm_base.reaped, &rp->super);
+        PRTE_RELEASE(rp);
+    }
     coll = PRTE_NEW(prte_grpcomm_coll_t);
     prte_dss.copy((void **)&coll->sig, (void *)sig, PRTE_SIGNATURE);
+    coll->sorted = sorted;
+    coll->sighash = hash;
+    coll->start = now;
 
     if (1 < prte_output_get_verbosity(prte_grpcomm_base_framework.framework_output)) {
         char *tmp=NULL;
@@ -327,10 +586,32 @@ prte_grpcomm_coll_t* prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig
     }
 
     prte_list_append(&prte_grpcomm_base.ongoing, &coll->super);
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint64(&prte_grpcomm_base.coll_table,
+                                                          hash, (void**)&cptr)) {
+        prte_grpcomm_base.nunindexed++;
+        coll->counted = true;
+    } else {
+        prte_hash_table_set_value_uint64(&prte_grpcomm_base.coll_table, hash, coll);
+        coll->indexed = true;
+    }
+
+    /* make sure it will be reclaimed if it never completes */
+    if (0 < prte_grpcomm_base.coll_timeout && !prte_grpcomm_base.reaper_active) {
+        struct timeval tv;
+        tv.tv_sec = prte_grpcomm_base.coll_timeout;
+        tv.tv_usec = 0;
+        prte_event_evtimer_set(prte_event_base, &prte_grpcomm_base.reaper,
+                               reap_trackers, NULL);
+        prte_event_evtimer_add(&prte_grpcomm_base.reaper, &tv);
+        prte_grpcomm_base.reaper_active = true;
+    }
 
     /* now get the daemons involved */
     if (PRTE_SUCCESS != (rc = create_dmns(sig, &coll->dmns, &coll->ndmns))) {
         PRTE_ERROR_LOG(rc);
+        /* releasing it also takes it out of the index */
+        prte_list_remove_item(&prte_grpcomm_base.ongoing, &coll->super);
+        PRTE_RELEASE(coll);
         return NULL;
     }
 
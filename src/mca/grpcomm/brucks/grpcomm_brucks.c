@@ -0,0 +1,105 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2014-2020 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include "src/mca/rml/rml_types.h"
+
+#include "src/mca/grpcomm/base/base.h"
+#include "grpcomm_brucks.h"
+
+/* Bruck's allgather: in round k, each daemon sends everything it
+ * has collected so far to the daemon 2^k ranks below it and receives
+ * from the daemon 2^k ranks above it. After ceil(log2(N)) rounds
+ * every daemon holds all N contributions, without any daemon acting
+ * as a root. Contributions are kept indexed by their distance (in
+ * ranks) above us, so that the blocks exchanged in round k always
+ * land in slots [2^k, 2^(k+1)). Daemon counts that aren't a power
+ * of two simply send fewer blocks in the final round */
+
+/* Static API's */
+static int init(void);
+static void finalize(void);
+static int allgather(prte_grpcomm_coll_t *coll,
+                     prte_buffer_t *buf, int mode);
+
+/* Module def */
+prte_grpcomm_base_module_t prte_grpcomm_brucks_module = {
+    .init = init,
+    .finalize = finalize,
+    .xcast = NULL,
+    .allgather = allgather,
+    .rbcast = NULL,
+    .register_cb = NULL,
+    .unregister_cb = NULL
+};
+
+/* our peer in a round is 2^round ranks below us */
+static size_t brucks_peer(prte_grpcomm_coll_t *coll, uint32_t round)
+{
+    size_t distance = (size_t)1 << round;
+
+    return (coll->my_rank + coll->ndmns - distance) % coll->ndmns;
+}
+
+/* in the final round of a non-power-of-two exchange, our
+ * peer only lacks the blocks that wrap around to it */
+static int32_t brucks_nblocks(prte_grpcomm_coll_t *coll, uint32_t round)
+{
+    size_t distance = (size_t)1 << round;
+
+    return (int32_t)((coll->ndmns - distance < distance) ? coll->ndmns - distance : distance);
+}
+
+static size_t brucks_slot(prte_grpcomm_coll_t *coll, size_t rank)
+{
+    return (rank + coll->ndmns - coll->my_rank) % coll->ndmns;
+}
+
+static prte_grpcomm_base_exchange_t brucks_exchange = {
+    .name = "brucks",
+    .tag = PRTE_RML_TAG_ALLGATHER_BRUCKS,
+    .peer = brucks_peer,
+    .nblocks = brucks_nblocks,
+    .slot = brucks_slot
+};
+
+/**
+ * Initialize the module
+ */
+static int init(void)
+{
+    prte_grpcomm_base_exchange_init(&brucks_exchange);
+    return PRTE_SUCCESS;
+}
+
+/**
+ * Finalize the module
+ */
+static void finalize(void)
+{
+    prte_grpcomm_base_exchange_finalize(&brucks_exchange);
+    return;
+}
+
+static int allgather(prte_grpcomm_coll_t *coll,
+                     prte_buffer_t *buf, int mode)
+{
+    /* we cannot assign a context id without a root, and every
+     * daemon must reach the same decision here */
+    if ((PRTE_GRPCOMM_MODE_CID & mode) ||
+        coll->ndmns < (size_t)prte_grpcomm_brucks_min_daemons) {
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    return prte_grpcomm_base_exchange_allgather(&brucks_exchange, coll, buf, mode);
+}
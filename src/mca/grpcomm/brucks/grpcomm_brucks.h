@@ -0,0 +1,34 @@
+/* -*- C -*-
+ *
+ * Copyright (c) 2014-2020 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+#ifndef GRPCOMM_BRUCKS_H
+#define GRPCOMM_BRUCKS_H
+
+#include "prte_config.h"
+
+
+#include "src/mca/grpcomm/grpcomm.h"
+
+BEGIN_C_DECLS
+
+/*
+ * Grpcomm interfaces
+ */
+
+PRTE_MODULE_EXPORT extern prte_grpcomm_base_component_t prte_grpcomm_brucks_component;
+extern prte_grpcomm_base_module_t prte_grpcomm_brucks_module;
+
+/* collectives involving fewer daemons are left to
+ * the next component */
+extern int prte_grpcomm_brucks_min_daemons;
+
+END_C_DECLS
+
+#endif
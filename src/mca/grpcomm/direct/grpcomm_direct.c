@@ -63,6 +63,9 @@ prte_grpcomm_base_module_t prte_grpcomm_direct_module = {
 static void xcast_recv(int status, prte_process_name_t* sender,
                        prte_buffer_t* buffer, prte_rml_tag_t tag,
                        void* cbdata);
+static void xcast_chunk_recv(int status, prte_process_name_t* sender,
+                             prte_buffer_t* buffer, prte_rml_tag_t tag,
+                             void* cbdata);
 static void allgather_recv(int status, prte_process_name_t* sender,
                            prte_buffer_t* buffer, prte_rml_tag_t tag,
                            void* cbdata);
@@ -70,8 +73,33 @@ static void barrier_release(int status, prte_process_name_t* sender,
                             prte_buffer_t* buffer, prte_rml_tag_t tag,
                             void* cbdata);
 
+/* tracks the reassembly of a chunked xcast payload */
+typedef struct {
+    prte_list_item_t super;
+    uint32_t id;
+    size_t size;
+    size_t recvd;
+    char *bytes;
+} xcast_chunks_t;
+static void chunks_con(xcast_chunks_t *p)
+{
+    p->size = 0;
+    p->recvd = 0;
+    p->bytes = NULL;
+}
+static void chunks_des(xcast_chunks_t *p)
+{
+    if (NULL != p->bytes) {
+        free(p->bytes);
+    }
+}
+static PRTE_CLASS_INSTANCE(xcast_chunks_t,
+                           prte_list_item_t,
+                           chunks_con, chunks_des);
+
 /* internal variables */
 static prte_list_t tracker;
+static prte_list_t chunks;
 
 /**
  * Initialize the module
@@ -79,12 +107,17 @@ static prte_list_t tracker;
 static int init(void)
 {
     PRTE_CONSTRUCT(&tracker, prte_list_t);
+    PRTE_CONSTRUCT(&chunks, prte_list_t);
 
     /* post the receives */
     prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD,
                             PRTE_RML_TAG_XCAST,
                             PRTE_RML_PERSISTENT,
                             xcast_recv, NULL);
+    prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD,
+                            PRTE_RML_TAG_XCAST_CHUNK,
+                            PRTE_RML_PERSISTENT,
+                            xcast_chunk_recv, NULL);
     prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD,
                             PRTE_RML_TAG_ALLGATHER_DIRECT,
                             PRTE_RML_PERSISTENT,
@@ -104,6 +137,7 @@ static int init(void)
 static void finalize(void)
 {
     PRTE_LIST_DESTRUCT(&tracker);
+    PRTE_LIST_DESTRUCT(&chunks);
     return;
 }
 
@@ -124,6 +158,157 @@ static int xcast(prte_vpid_t *vpids,
     return PRTE_SUCCESS;
 }
 
+/* FNV-1a hash of a contribution */
+static uint64_t blob_hash(const uint8_t *bytes, int32_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    int32_t n;
+
+    for (n=0; n < size; n++) {
+        hash ^= bytes[n];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* add a contribution to the list, merging its contributors into
+ * those of an identical contribution if we already have one. Takes
+ * ownership of the data and the vpid array */
+static void add_blob(prte_list_t *blobs, prte_hash_table_t *index,
+                     prte_byte_object_t *data, prte_vpid_t *vpids, int32_t nvpids)
+{
+    prte_grpcomm_blob_t *blob = NULL;
+    void *ptr;
+    uint64_t hash;
+
+    hash = blob_hash(data->bytes, data->size);
+    if (NULL != index) {
+        if (prte_list_is_empty(blobs)) {
+            prte_hash_table_init(index, 32);
+        }
+        if (PRTE_SUCCESS == prte_hash_table_get_value_uint64(index, hash, (void**)&blob) &&
+            NULL != blob && blob->data.size == data->size &&
+            (0 == data->size || 0 == memcmp(blob->data.bytes, data->bytes, data->size))) {
+            /* we already have it - just add the contributors */
+            if (blob->nalloc < blob->nvpids + nvpids) {
+                blob->nalloc = 2 * (blob->nvpids + nvpids);
+                blob->vpids = (prte_vpid_t*)realloc(blob->vpids, blob->nalloc * sizeof(prte_vpid_t));
+            }
+            memcpy(&blob->vpids[blob->nvpids], vpids, nvpids * sizeof(prte_vpid_t));
+            blob->nvpids += nvpids;
+            if (NULL != data->bytes) {
+                free(data->bytes);
+            }
+            free(vpids);
+            return;
+        }
+    }
+    blob = PRTE_NEW(prte_grpcomm_blob_t);
+    blob->hash = hash;
+    blob->data = *data;
+    blob->vpids = vpids;
+    blob->nvpids = nvpids;
+    blob->nalloc = nvpids;
+    /* on a hash collision, the first blob keeps the index entry
+     * and this one simply won't be merged with others */
+    if (NULL != index &&
+        PRTE_SUCCESS != prte_hash_table_get_value_uint64(index, hash, &ptr)) {
+        prte_hash_table_set_value_uint64(index, hash, blob);
+    }
+    prte_list_append(blobs, &blob->super);
+}
+
+static int pack_blobs(prte_buffer_t *buf, prte_list_t *blobs)
+{
+    prte_grpcomm_blob_t *blob;
+    prte_byte_object_t *bo;
+    int32_t nblobs;
+    int rc;
+
+    nblobs = prte_list_get_size(blobs);
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &nblobs, 1, PRTE_INT32))) {
+        return rc;
+    }
+    PRTE_LIST_FOREACH(blob, blobs, prte_grpcomm_blob_t) {
+        bo = &blob->data;
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &bo, 1, PRTE_BYTE_OBJECT)) ||
+            PRTE_SUCCESS != (rc = prte_dss.pack(buf, &blob->nvpids, 1, PRTE_INT32)) ||
+            PRTE_SUCCESS != (rc = prte_dss.pack(buf, blob->vpids, blob->nvpids, PRTE_VPID))) {
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+/* unpack a list of contributions - if an index is given,
+ * identical contributions are merged */
+static int unpack_blobs(prte_buffer_t *buf, prte_list_t *blobs, prte_hash_table_t *index)
+{
+    prte_byte_object_t *bo;
+    prte_vpid_t *vpids;
+    int32_t n, nblobs, nvpids, cnt;
+    int rc;
+
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &nblobs, &cnt, PRTE_INT32))) {
+        return rc;
+    }
+    for (n=0; n < nblobs; n++) {
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &bo, &cnt, PRTE_BYTE_OBJECT))) {
+            return rc;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &nvpids, &cnt, PRTE_INT32))) {
+            if (NULL != bo->bytes) {
+                free(bo->bytes);
+            }
+            free(bo);
+            return rc;
+        }
+        vpids = (prte_vpid_t*)malloc(nvpids * sizeof(prte_vpid_t));
+        cnt = nvpids;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, vpids, &cnt, PRTE_VPID))) {
+            free(vpids);
+            if (NULL != bo->bytes) {
+                free(bo->bytes);
+            }
+            free(bo);
+            return rc;
+        }
+        add_blob(blobs, index, bo, vpids, nvpids);
+        free(bo);
+    }
+    return PRTE_SUCCESS;
+}
+
+/* pass on everything collected so far. Each daemon decides for
+ * itself whether to deduplicate its own contribution, and each
+ * message says which form it is in - so once any deduplicated
+ * contribution has arrived, the plain ones we also hold are added
+ * as a single contribution from us. Only the number of times a
+ * contribution occurs matters when the result is expanded */
+static int pack_collected(prte_buffer_t *buf, prte_grpcomm_coll_t *coll)
+{
+    prte_byte_object_t bo;
+    prte_vpid_t *me;
+
+    if (!coll->dedup) {
+        return prte_dss.copy_payload(buf, &coll->bucket);
+    }
+    if (0 < coll->bucket.bytes_used) {
+        bo.size = coll->bucket.bytes_used;
+        bo.bytes = (uint8_t*)malloc(bo.size);
+        memcpy(bo.bytes, coll->bucket.base_ptr, bo.size);
+        me = (prte_vpid_t*)malloc(sizeof(prte_vpid_t));
+        *me = PRTE_PROC_MY_NAME->vpid;
+        add_blob(&coll->blobs, &coll->blob_index, &bo, me, 1);
+        PRTE_DESTRUCT(&coll->bucket);
+        PRTE_CONSTRUCT(&coll->bucket, prte_buffer_t);
+    }
+    return pack_blobs(buf, &coll->blobs);
+}
+
 static int allgather(prte_grpcomm_coll_t *coll,
                      prte_buffer_t *buf, int mode)
 {
@@ -154,7 +339,32 @@ static int allgather(prte_grpcomm_coll_t *coll,
     }
 
     /* pass along the payload */
-    prte_dss.copy_payload(relay, buf);
+    if (PRTE_GRPCOMM_MODE_DEDUP & mode) {
+        /* as a single contribution from us */
+        prte_list_t blobs;
+        prte_byte_object_t bo;
+        prte_vpid_t *me;
+
+        PRTE_CONSTRUCT(&blobs, prte_list_t);
+        bo.size = buf->bytes_used - (buf->unpack_ptr - buf->base_ptr);
+        bo.bytes = NULL;
+        if (0 < bo.size) {
+            bo.bytes = (uint8_t*)malloc(bo.size);
+            memcpy(bo.bytes, buf->unpack_ptr, bo.size);
+        }
+        me = (prte_vpid_t*)malloc(sizeof(prte_vpid_t));
+        *me = PRTE_PROC_MY_NAME->vpid;
+        add_blob(&blobs, NULL, &bo, me, 1);
+        rc = pack_blobs(relay, &blobs);
+        PRTE_LIST_DESTRUCT(&blobs);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_RELEASE(relay);
+            return rc;
+        }
+    } else {
+        prte_dss.copy_payload(relay, buf);
+    }
 
     /* send this to ourselves for processing */
     PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
@@ -205,8 +415,17 @@ static void allgather_recv(int status, prte_process_name_t* sender,
     }
     /* increment nprocs reported for collective */
     coll->nreported++;
-    /* capture any provided content */
-    prte_dss.copy_payload(&coll->bucket, buffer);
+    /* capture any provided content in whatever form the sender used */
+    if (PRTE_GRPCOMM_MODE_DEDUP & mode) {
+        if (PRTE_SUCCESS != (rc = unpack_blobs(buffer, &coll->blobs, &coll->blob_index))) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_RELEASE(sig);
+            return;
+        }
+        coll->dedup = true;
+    } else {
+        prte_dss.copy_payload(&coll->bucket, buffer);
+    }
 
     PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
                          "%s grpcomm:direct allgather recv nexpected %d nrep %d",
@@ -215,6 +434,12 @@ static void allgather_recv(int status, prte_process_name_t* sender,
 
     /* see if everyone has reported */
     if (coll->nreported == coll->nexpected) {
+        /* what we pass on is in the form of what we collected */
+        if (coll->dedup) {
+            mode |= PRTE_GRPCOMM_MODE_DEDUP;
+        } else {
+            mode &= ~PRTE_GRPCOMM_MODE_DEDUP;
+        }
         if (PRTE_PROC_IS_MASTER) {
             PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
                                  "%s grpcomm:direct allgather HNP reports complete",
@@ -245,7 +470,7 @@ static void allgather_recv(int status, prte_process_name_t* sender,
                 return;
             }
             /* if we were asked to provide a context id, do so */
-            if (1 == mode) {
+            if (PRTE_GRPCOMM_MODE_CID & mode) {
                 size_t sz;
                 sz = prte_grpcomm_base.context_id;
                 ++prte_grpcomm_base.context_id;
@@ -257,7 +482,12 @@ static void allgather_recv(int status, prte_process_name_t* sender,
                 }
             }
             /* transfer the collected bucket */
-            prte_dss.copy_payload(reply, &coll->bucket);
+            if (PRTE_SUCCESS != (rc = pack_collected(reply, coll))) {
+                PRTE_ERROR_LOG(rc);
+                PRTE_RELEASE(reply);
+                PRTE_RELEASE(sig);
+                return;
+            }
             /* send the release via xcast */
             (void)prte_grpcomm.xcast(sig, PRTE_RML_TAG_COLL_RELEASE, reply);
             PRTE_RELEASE(reply);
@@ -283,7 +513,12 @@ static void allgather_recv(int status, prte_process_name_t* sender,
                 return;
             }
             /* transfer the collected bucket */
-            prte_dss.copy_payload(reply, &coll->bucket);
+            if (PRTE_SUCCESS != (rc = pack_collected(reply, coll))) {
+                PRTE_ERROR_LOG(rc);
+                PRTE_RELEASE(reply);
+                PRTE_RELEASE(sig);
+                return;
+            }
             /* send the info to our parent */
             rc = prte_rml.send_buffer_nb(PRTE_PROC_MY_PARENT, reply,
                                          PRTE_RML_TAG_ALLGATHER_DIRECT,
@@ -293,80 +528,143 @@ static void allgather_recv(int status, prte_process_name_t* sender,
     PRTE_RELEASE(sig);
 }
 
-static void xcast_recv(int status, prte_process_name_t* sender,
-                       prte_buffer_t* buffer, prte_rml_tag_t tg,
-                       void* cbdata)
+/* send a message to each of the given recipients - returns true
+ * if the message was handed to the RML for at least one of them */
+static bool relay(prte_list_t *coll, prte_buffer_t *msg, prte_rml_tag_t tag)
 {
-    prte_list_item_t *item;
     prte_namelist_t *nm;
+    prte_job_t *jdata;
+    prte_proc_t *rec;
+    bool relayed = false;
+    int ret;
+
+    PRTE_LIST_FOREACH(nm, coll, prte_namelist_t) {
+        PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:direct:send_relay sending relay msg of %d bytes to %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int)msg->bytes_used,
+                             PRTE_NAME_PRINT(&nm->name)));
+        /* check the state of the recipient - no point
+         * sending to someone not alive
+         */
+        jdata = prte_get_job_data_object(nm->name.jobid);
+        if (NULL == (rec = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, nm->name.vpid))) {
+            if (!prte_abnormal_term_ordered && !prte_prteds_term_ordered) {
+                prte_output(0, "%s grpcomm:direct:send_relay proc %s not found - cannot relay",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&nm->name));
+            }
+            PRTE_FORCED_TERMINATE(PRTE_ERR_UNREACH);
+            continue;
+        }
+        if ((PRTE_PROC_STATE_RUNNING < rec->state &&
+            PRTE_PROC_STATE_CALLED_ABORT != rec->state) ||
+            !PRTE_FLAG_TEST(rec, PRTE_PROC_FLAG_ALIVE)) {
+            if (!prte_abnormal_term_ordered && !prte_prteds_term_ordered) {
+                prte_output(0, "%s grpcomm:direct:send_relay proc %s not running - cannot relay: %s ",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&nm->name),
+                            PRTE_FLAG_TEST(rec, PRTE_PROC_FLAG_ALIVE) ? prte_proc_state_to_str(rec->state) : "NOT ALIVE");
+            }
+            PRTE_FORCED_TERMINATE(PRTE_ERR_UNREACH);
+            continue;
+        }
+        PRTE_RETAIN(msg);
+        if (PRTE_SUCCESS != (ret = prte_rml.send_buffer_nb(&nm->name, msg, tag,
+                                                           prte_rml_send_callback, NULL))) {
+            PRTE_ERROR_LOG(ret);
+            PRTE_RELEASE(msg);
+            PRTE_FORCED_TERMINATE(PRTE_ERR_UNREACH);
+            continue;
+        }
+        relayed = true;
+    }
+    return relayed;
+}
+
+/* split the payload into fixed-size chunks and send each of them
+ * on to the recipients - the daemons below us forward each chunk
+ * as soon as it arrives and reassemble the payload for their own
+ * use in parallel */
+static void relay_chunks(prte_list_t *coll, prte_buffer_t *msg)
+{
+    static uint32_t next_id = 0;
+    prte_buffer_t *chunk;
+    size_t size, offset, len;
+    uint32_t id;
+    int ret;
+
+    id = next_id++;
+    size = msg->bytes_used;
+    for (offset=0; offset < size; offset += len) {
+        len = size - offset;
+        if ((size_t)prte_grpcomm_direct_xcast_chunk_size < len) {
+            len = prte_grpcomm_direct_xcast_chunk_size;
+        }
+        chunk = PRTE_NEW(prte_buffer_t);
+        if (PRTE_SUCCESS != (ret = prte_dss.pack(chunk, &id, 1, PRTE_UINT32)) ||
+            PRTE_SUCCESS != (ret = prte_dss.pack(chunk, &size, 1, PRTE_SIZE)) ||
+            PRTE_SUCCESS != (ret = prte_dss.pack(chunk, &offset, 1, PRTE_SIZE)) ||
+            PRTE_SUCCESS != (ret = prte_dss.pack(chunk, &len, 1, PRTE_SIZE)) ||
+            PRTE_SUCCESS != (ret = prte_dss.pack(chunk, msg->base_ptr + offset, len, PRTE_UINT8))) {
+            PRTE_ERROR_LOG(ret);
+            PRTE_RELEASE(chunk);
+            PRTE_FORCED_TERMINATE(ret);
+            return;
+        }
+        relay(coll, chunk, PRTE_RML_TAG_XCAST_CHUNK);
+        PRTE_RELEASE(chunk);
+    }
+}
+
+/* unpack the xcast payload and pass it to ourselves for processing. If
+ * the payload is shared with relays still in flight, then we have to
+ * take our own copy of it */
+static void xcast_deliver(prte_buffer_t *rly, bool shared)
+{
     int ret, cnt;
-    prte_buffer_t *relay=NULL, *rly;
+    prte_buffer_t *relay=NULL;
     prte_daemon_cmd_flag_t command = PRTE_DAEMON_NULL_CMD;
     prte_buffer_t datbuf, *data;
     int8_t flag;
-    prte_job_t *jdata;
-    prte_proc_t *rec;
-    prte_list_t coll;
     prte_grpcomm_signature_t *sig;
     prte_rml_tag_t tag;
     size_t inlen, cmplen;
     uint8_t *packed_data, *cmpdata;
 
-    PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
-                         "%s grpcomm:direct:xcast:recv: with %d bytes",
-                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                         (int)buffer->bytes_used));
-
-    /* we need a passthru buffer to send to our children - we leave it
-     * as compressed data */
-    rly = PRTE_NEW(prte_buffer_t);
-    prte_dss.copy_payload(rly, buffer);
     PRTE_CONSTRUCT(&datbuf, prte_buffer_t);
-    /* setup the relay list */
-    PRTE_CONSTRUCT(&coll, prte_list_t);
 
     /* unpack the flag to see if this payload is compressed */
     cnt=1;
-    if (PRTE_SUCCESS != (ret = prte_dss.unpack(buffer, &flag, &cnt, PRTE_INT8))) {
+    if (PRTE_SUCCESS != (ret = prte_dss.unpack(rly, &flag, &cnt, PRTE_INT8))) {
         PRTE_ERROR_LOG(ret);
         PRTE_FORCED_TERMINATE(ret);
         PRTE_DESTRUCT(&datbuf);
-        PRTE_DESTRUCT(&coll);
-        PRTE_RELEASE(rly);
         return;
     }
     if (flag) {
         /* unpack the data size */
         cnt=1;
-        if (PRTE_SUCCESS != (ret = prte_dss.unpack(buffer, &inlen, &cnt, PRTE_SIZE))) {
+        if (PRTE_SUCCESS != (ret = prte_dss.unpack(rly, &inlen, &cnt, PRTE_SIZE))) {
             PRTE_ERROR_LOG(ret);
             PRTE_FORCED_TERMINATE(ret);
             PRTE_DESTRUCT(&datbuf);
-            PRTE_DESTRUCT(&coll);
-            PRTE_RELEASE(rly);
             return;
         }
         /* unpack the unpacked data size */
         cnt=1;
-        if (PRTE_SUCCESS != (ret = prte_dss.unpack(buffer, &cmplen, &cnt, PRTE_SIZE))) {
+        if (PRTE_SUCCESS != (ret = prte_dss.unpack(rly, &cmplen, &cnt, PRTE_SIZE))) {
             PRTE_ERROR_LOG(ret);
             PRTE_FORCED_TERMINATE(ret);
             PRTE_DESTRUCT(&datbuf);
-            PRTE_DESTRUCT(&coll);
-            PRTE_RELEASE(rly);
             return;
         }
         /* allocate the space */
         packed_data = (uint8_t*)malloc(inlen);
         /* unpack the data blob */
         cnt = inlen;
-        if (PRTE_SUCCESS != (ret = prte_dss.unpack(buffer, packed_data, &cnt, PRTE_UINT8))) {
+        if (PRTE_SUCCESS != (ret = prte_dss.unpack(rly, packed_data, &cnt, PRTE_UINT8))) {
             PRTE_ERROR_LOG(ret);
             free(packed_data);
             PRTE_FORCED_TERMINATE(ret);
             PRTE_DESTRUCT(&datbuf);
-            PRTE_DESTRUCT(&coll);
-            PRTE_RELEASE(rly);
             return;
         }
         /* decompress the data */
@@ -376,11 +674,11 @@ static void xcast_recv(int status, prte_process_name_t* sender,
             prte_dss.load(&datbuf, cmpdata, cmplen);
             data = &datbuf;
         } else {
-            data = buffer;
+            data = rly;
         }
         free(packed_data);
     } else {
-        data = buffer;
+        data = rly;
     }
 
     /* get the signature that we do not need */
@@ -388,8 +686,6 @@ static void xcast_recv(int status, prte_process_name_t* sender,
     if (PRTE_SUCCESS != (ret = prte_dss.unpack(data, &sig, &cnt, PRTE_SIGNATURE))) {
         PRTE_ERROR_LOG(ret);
         PRTE_DESTRUCT(&datbuf);
-        PRTE_DESTRUCT(&coll);
-        PRTE_RELEASE(rly);
         PRTE_FORCED_TERMINATE(ret);
         return;
     }
@@ -400,18 +696,58 @@ static void xcast_recv(int status, prte_process_name_t* sender,
     if (PRTE_SUCCESS != (ret = prte_dss.unpack(data, &tag, &cnt, PRTE_RML_TAG))) {
         PRTE_ERROR_LOG(ret);
         PRTE_DESTRUCT(&datbuf);
-        PRTE_DESTRUCT(&coll);
-        PRTE_RELEASE(rly);
         PRTE_FORCED_TERMINATE(ret);
         return;
     }
 
-    /* copy the msg for relay to ourselves */
-    relay = PRTE_NEW(prte_buffer_t);
-    prte_dss.copy_payload(relay, data);
+    /* now pass the remaining data to myself for processing - don't
+     * inject it into the RML system via send as that will compete
+     * with the relay messages down in the OOB. Instead, pass it
+     * directly to the RML message processor */
+    if (PRTE_DAEMON_DVM_NIDMAP_CMD != command) {
+        if (data == rly && shared) {
+            /* the relays still reference the passthru data, so
+             * we need our own copy */
+            relay = PRTE_NEW(prte_buffer_t);
+            prte_dss.copy_payload(relay, data);
+            data = relay;
+        }
+        /* hand over the data without copying it again */
+        PRTE_RML_POST_BUFFER(PRTE_PROC_MY_NAME, tag, 1, data);
+    }
+    if (NULL != relay) {
+        PRTE_RELEASE(relay);
+    }
+    PRTE_DESTRUCT(&datbuf);
+}
+
+static void xcast_recv(int status, prte_process_name_t* sender,
+                       prte_buffer_t* buffer, prte_rml_tag_t tg,
+                       void* cbdata)
+{
+    prte_buffer_t *rly;
+    prte_list_t coll;
+    bool relayed = false;
+    char *bytes;
+    int32_t nbytes;
+
+    PRTE_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:xcast:recv: with %d bytes",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         (int)buffer->bytes_used));
+
+    /* we need a passthru buffer to send to our children - we leave it
+     * as compressed data. Nothing has been unpacked yet, so we can
+     * take over the received data instead of copying it. The same
+     * buffer is then retained by each relay send and unpacked
+     * here for our own use */
+    rly = PRTE_NEW(prte_buffer_t);
+    prte_dss.unload(buffer, (void**)&bytes, &nbytes);
+    prte_dss.load(rly, bytes, nbytes);
 
     if (!prte_do_not_launch) {
         /* get the list of next recipients from the routed module */
+        PRTE_CONSTRUCT(&coll, prte_list_t);
         prte_routed.get_routing_list(&coll);
 
         /* if list is empty, no relay is required */
@@ -419,76 +755,103 @@ static void xcast_recv(int status, prte_process_name_t* sender,
             PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
                                  "%s grpcomm:direct:send_relay - recipient list is empty!",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-            goto CLEANUP;
+        } else if (0 < prte_grpcomm_direct_xcast_chunk_size &&
+                   0 < prte_grpcomm_direct_xcast_chunk_threshold &&
+                   (size_t)prte_grpcomm_direct_xcast_chunk_threshold < rly->bytes_used) {
+            /* the chunks carry their own copy of the data */
+            relay_chunks(&coll, rly);
+        } else {
+            relayed = relay(&coll, rly, PRTE_RML_TAG_XCAST);
         }
+        PRTE_LIST_DESTRUCT(&coll);
+    }
 
-        /* send the message to each recipient on list, deconstructing it as we go */
-        while (NULL != (item = prte_list_remove_first(&coll))) {
-            nm = (prte_namelist_t*)item;
+    xcast_deliver(rly, relayed);
+    PRTE_RELEASE(rly);
+}
 
-            PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:direct:send_relay sending relay msg of %d bytes to %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int)rly->bytes_used,
-                                 PRTE_NAME_PRINT(&nm->name)));
-            PRTE_RETAIN(rly);
-            /* check the state of the recipient - no point
-             * sending to someone not alive
-             */
-            jdata = prte_get_job_data_object(nm->name.jobid);
-            if (NULL == (rec = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, nm->name.vpid))) {
-                if (!prte_abnormal_term_ordered && !prte_prteds_term_ordered) {
-                    prte_output(0, "%s grpcomm:direct:send_relay proc %s not found - cannot relay",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&nm->name));
-                }
-                PRTE_RELEASE(rly);
-                PRTE_RELEASE(item);
-                PRTE_FORCED_TERMINATE(PRTE_ERR_UNREACH);
-                continue;
-            }
-            if ((PRTE_PROC_STATE_RUNNING < rec->state &&
-                PRTE_PROC_STATE_CALLED_ABORT != rec->state) ||
-                !PRTE_FLAG_TEST(rec, PRTE_PROC_FLAG_ALIVE)) {
-                if (!prte_abnormal_term_ordered && !prte_prteds_term_ordered) {
-                    prte_output(0, "%s grpcomm:direct:send_relay proc %s not running - cannot relay: %s ",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&nm->name),
-                                PRTE_FLAG_TEST(rec, PRTE_PROC_FLAG_ALIVE) ? prte_proc_state_to_str(rec->state) : "NOT ALIVE");
-                }
-                PRTE_RELEASE(rly);
-                PRTE_RELEASE(item);
-                PRTE_FORCED_TERMINATE(PRTE_ERR_UNREACH);
-                continue;
-            }
-            if (PRTE_SUCCESS != (ret = prte_rml.send_buffer_nb(&nm->name, rly, PRTE_RML_TAG_XCAST,
-                                                               prte_rml_send_callback, NULL))) {
-                PRTE_ERROR_LOG(ret);
-                PRTE_RELEASE(rly);
-                PRTE_RELEASE(item);
-                PRTE_FORCED_TERMINATE(PRTE_ERR_UNREACH);
-                continue;
-            }
-            PRTE_RELEASE(item);
-        }
-    }
+static void xcast_chunk_recv(int status, prte_process_name_t* sender,
+                             prte_buffer_t* buffer, prte_rml_tag_t tg,
+                             void* cbdata)
+{
+    prte_buffer_t *rly, *msg;
+    prte_list_t coll;
+    xcast_chunks_t *trk, *t;
+    uint32_t id;
+    size_t size, offset, len;
+    char *bytes;
+    int32_t nbytes;
+    int ret, cnt;
 
- CLEANUP:
-    /* cleanup */
-    PRTE_LIST_DESTRUCT(&coll);
-    PRTE_RELEASE(rly);  // retain accounting
+    /* pass the chunk along untouched before doing anything else */
+    rly = PRTE_NEW(prte_buffer_t);
+    prte_dss.unload(buffer, (void**)&bytes, &nbytes);
+    prte_dss.load(rly, bytes, nbytes);
+    if (!prte_do_not_launch) {
+        PRTE_CONSTRUCT(&coll, prte_list_t);
+        prte_routed.get_routing_list(&coll);
+        relay(&coll, rly, PRTE_RML_TAG_XCAST_CHUNK);
+        PRTE_LIST_DESTRUCT(&coll);
+    }
 
-    /* now pass the relay buffer to myself for processing - don't
-     * inject it into the RML system via send as that will compete
-     * with the relay messages down in the OOB. Instead, pass it
-     * directly to the RML message processor */
-    if (PRTE_DAEMON_DVM_NIDMAP_CMD != command) {
-        PRTE_RML_POST_MESSAGE(PRTE_PROC_MY_NAME, tag, 1,
-                              relay->base_ptr, relay->bytes_used);
-        relay->base_ptr = NULL;
-        relay->bytes_used = 0;
+    cnt = 1;
+    if (PRTE_SUCCESS != (ret = prte_dss.unpack(rly, &id, &cnt, PRTE_UINT32)) ||
+        PRTE_SUCCESS != (ret = prte_dss.unpack(rly, &size, &cnt, PRTE_SIZE)) ||
+        PRTE_SUCCESS != (ret = prte_dss.unpack(rly, &offset, &cnt, PRTE_SIZE)) ||
+        PRTE_SUCCESS != (ret = prte_dss.unpack(rly, &len, &cnt, PRTE_SIZE))) {
+        PRTE_ERROR_LOG(ret);
+        PRTE_RELEASE(rly);
+        PRTE_FORCED_TERMINATE(ret);
+        return;
     }
-    if (NULL != relay) {
-        PRTE_RELEASE(relay);
+    PRTE_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:xcast:chunk %u recvd %d bytes at offset %d of %d",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), id,
+                         (int)len, (int)offset, (int)size));
+
+    /* find the payload this chunk belongs to */
+    trk = NULL;
+    PRTE_LIST_FOREACH(t, &chunks, xcast_chunks_t) {
+        if (t->id == id) {
+            trk = t;
+            break;
+        }
     }
-    PRTE_DESTRUCT(&datbuf);
+    if (NULL == trk) {
+        trk = PRTE_NEW(xcast_chunks_t);
+        trk->id = id;
+        trk->size = size;
+        trk->bytes = (char*)malloc(size);
+        prte_list_append(&chunks, &trk->super);
+    }
+    if (size != trk->size || trk->size < offset + len) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        PRTE_RELEASE(rly);
+        PRTE_FORCED_TERMINATE(PRTE_ERR_BAD_PARAM);
+        return;
+    }
+    /* unpack the data straight into place */
+    cnt = len;
+    if (PRTE_SUCCESS != (ret = prte_dss.unpack(rly, trk->bytes + offset, &cnt, PRTE_UINT8))) {
+        PRTE_ERROR_LOG(ret);
+        PRTE_RELEASE(rly);
+        PRTE_FORCED_TERMINATE(ret);
+        return;
+    }
+    PRTE_RELEASE(rly);
+    trk->recvd += len;
+    if (trk->recvd < trk->size) {
+        return;
+    }
+
+    /* we have it all - process it */
+    prte_list_remove_item(&chunks, &trk->super);
+    msg = PRTE_NEW(prte_buffer_t);
+    prte_dss.load(msg, trk->bytes, trk->size);
+    trk->bytes = NULL;
+    PRTE_RELEASE(trk);
+    xcast_deliver(msg, false);
+    PRTE_RELEASE(msg);
 }
 
 static void barrier_release(int status, prte_process_name_t* sender,
@@ -535,7 +898,52 @@ static void barrier_release(int status, prte_process_name_t* sender,
 
     /* execute the callback */
     if (NULL != coll->cbfunc) {
-        coll->cbfunc(ret, buffer, coll->cbdata);
+        if (PRTE_GRPCOMM_MODE_DEDUP & mode) {
+            /* give the callback the usual concatenation of
+             * contributions, one per contributor */
+            prte_buffer_t *result, tmp;
+            prte_list_t blobs;
+            prte_grpcomm_blob_t *blob;
+            size_t cid;
+            int32_t n;
+
+            result = PRTE_NEW(prte_buffer_t);
+            PRTE_CONSTRUCT(&blobs, prte_list_t);
+            if (PRTE_GRPCOMM_MODE_CID & mode) {
+                cnt = 1;
+                if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &cid, &cnt, PRTE_SIZE)) ||
+                    PRTE_SUCCESS != (rc = prte_dss.pack(result, &cid, 1, PRTE_SIZE))) {
+                    PRTE_ERROR_LOG(rc);
+                    ret = rc;
+                }
+            }
+            if (PRTE_SUCCESS == ret &&
+                PRTE_SUCCESS != (rc = unpack_blobs(buffer, &blobs, NULL))) {
+                PRTE_ERROR_LOG(rc);
+                ret = rc;
+            }
+            if (PRTE_SUCCESS == ret) {
+                PRTE_LIST_FOREACH(blob, &blobs, prte_grpcomm_blob_t) {
+                    if (0 == blob->data.size) {
+                        continue;
+                    }
+                    /* don't let the buffer take the blob's data */
+                    PRTE_CONSTRUCT(&tmp, prte_buffer_t);
+                    prte_dss.load(&tmp, blob->data.bytes, blob->data.size);
+                    for (n=0; n < blob->nvpids; n++) {
+                        tmp.unpack_ptr = tmp.base_ptr;
+                        prte_dss.copy_payload(result, &tmp);
+                    }
+                    tmp.base_ptr = NULL;
+                    PRTE_DESTRUCT(&tmp);
+                }
+            }
+            PRTE_LIST_DESTRUCT(&blobs);
+            coll->cbfunc(ret, result, coll->cbdata);
+            PRTE_RELEASE(result);
+        } else {
+            coll->cbfunc(ret, buffer, coll->cbdata);
+        }
     }
     prte_list_remove_item(&prte_grpcomm_base.ongoing, &coll->super);
     PRTE_RELEASE(coll);
@@ -28,6 +28,11 @@ BEGIN_C_DECLS
 PRTE_MODULE_EXPORT extern prte_grpcomm_base_component_t prte_grpcomm_direct_component;
 extern prte_grpcomm_base_module_t prte_grpcomm_direct_module;
 
+/* xcast payloads larger than the threshold are relayed
+ * in chunks of the given size (0 => disabled) */
+extern int prte_grpcomm_direct_xcast_chunk_threshold;
+extern int prte_grpcomm_direct_xcast_chunk_size;
+
 END_C_DECLS
 
 #endif
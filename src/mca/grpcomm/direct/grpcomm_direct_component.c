@@ -25,6 +25,8 @@
 #include "grpcomm_direct.h"
 
 static int my_priority=5;  /* must be below "bad" module */
+int prte_grpcomm_direct_xcast_chunk_threshold = 1048576;
+int prte_grpcomm_direct_xcast_chunk_size = 262144;
 static int direct_open(void);
 static int direct_close(void);
 static int direct_query(prte_mca_base_module_t **module, int *priority);
@@ -65,6 +67,22 @@ static int direct_register(void)
                                            PRTE_INFO_LVL_9,
                                            PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                            &my_priority);
+
+    prte_grpcomm_direct_xcast_chunk_threshold = 1048576;
+    (void) prte_mca_base_component_var_register(c, "xcast_chunk_threshold",
+                                           "Size (in bytes) above which xcast payloads are relayed in chunks that are forwarded as soon as they arrive (0 => never chunk)",
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prte_grpcomm_direct_xcast_chunk_threshold);
+
+    prte_grpcomm_direct_xcast_chunk_size = 262144;
+    (void) prte_mca_base_component_var_register(c, "xcast_chunk_size",
+                                           "Size (in bytes) of each chunk of a chunked xcast (0 => never chunk)",
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prte_grpcomm_direct_xcast_chunk_size);
     return PRTE_SUCCESS;
 }
 
@@ -47,6 +47,7 @@
 #include "src/mca/mca.h"
 #include "src/class/prte_list.h"
 #include "src/class/prte_bitmap.h"
+#include "src/class/prte_hash_table.h"
 #include "src/dss/dss_types.h"
 
 #include "src/mca/rml/rml_types.h"
@@ -68,12 +69,37 @@ typedef struct {
 } prte_grpcomm_signature_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_grpcomm_signature_t);
 
+/* allgather mode flags */
+#define PRTE_GRPCOMM_MODE_CID       0x01    // return a new context id with the result
+#define PRTE_GRPCOMM_MODE_DEDUP     0x02    // send identical contributions only once
+
+/* a unique allgather contribution along with the
+ * daemons that provided it - used to track the
+ * payload of a PRTE_GRPCOMM_MODE_DEDUP allgather */
+typedef struct {
+    prte_list_item_t super;
+    uint64_t hash;
+    prte_byte_object_t data;
+    prte_vpid_t *vpids;
+    int32_t nvpids;
+    int32_t nalloc;
+} prte_grpcomm_blob_t;
+PRTE_CLASS_DECLARATION(prte_grpcomm_blob_t);
+
 /* Internal component object for tracking ongoing
  * allgather operations */
 typedef struct {
     prte_list_item_t super;
-    /* collective's signature */
+    /* collective's signature, and its procs in sorted order */
     prte_grpcomm_signature_t *sig;
+    prte_process_name_t *sorted;
+    /* hash of the signature, and whether the tracker is in
+     * the base index under it or counted in nunindexed */
+    uint64_t sighash;
+    bool indexed;
+    bool counted;
+    /* time the tracker was created */
+    time_t start;
     /* collection bucket */
     prte_buffer_t bucket;
     /* participating daemons */
@@ -90,6 +116,15 @@ typedef struct {
     prte_bitmap_t distance_mask_recv;
     /* received buckets */
     prte_buffer_t ** buffers;
+    /* next exchange round to be sent */
+    uint32_t round;
+    /* unique contributions and their index by
+     * content hash (PRTE_GRPCOMM_MODE_DEDUP only) */
+    prte_list_t blobs;
+    prte_hash_table_t blob_index;
+    /* true if any contribution arrived in PRTE_GRPCOMM_MODE_DEDUP
+     * form - everything collected is then passed on in that form */
+    bool dedup;
     /* callback function */
     prte_grpcomm_cbfunc_t cbfunc;
     /* user-provided callback data */
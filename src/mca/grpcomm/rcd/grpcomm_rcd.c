@@ -0,0 +1,100 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2014-2020 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include "src/mca/rml/rml_types.h"
+
+#include "src/mca/grpcomm/base/base.h"
+#include "grpcomm_rcd.h"
+
+/* Recursive doubling allgather: in round k, each daemon exchanges
+ * everything it has collected so far with the daemon whose rank
+ * differs from its own only in bit k. After log2(N) rounds every
+ * daemon holds all N contributions, without any daemon acting as
+ * a root. The contribution of rank r is kept in slot (r ^ our rank),
+ * so the blocks received in round k land in slots [2^k, 2^(k+1)).
+ * Only power-of-two daemon counts are supported - any other
+ * collective is left to the next component */
+
+/* Static API's */
+static int init(void);
+static void finalize(void);
+static int allgather(prte_grpcomm_coll_t *coll,
+                     prte_buffer_t *buf, int mode);
+
+/* Module def */
+prte_grpcomm_base_module_t prte_grpcomm_rcd_module = {
+    .init = init,
+    .finalize = finalize,
+    .xcast = NULL,
+    .allgather = allgather,
+    .rbcast = NULL,
+    .register_cb = NULL,
+    .unregister_cb = NULL
+};
+
+static size_t rcd_peer(prte_grpcomm_coll_t *coll, uint32_t round)
+{
+    return coll->my_rank ^ ((size_t)1 << round);
+}
+
+/* our peer has none of the blocks we hold */
+static int32_t rcd_nblocks(prte_grpcomm_coll_t *coll, uint32_t round)
+{
+    return (int32_t)((size_t)1 << round);
+}
+
+static size_t rcd_slot(prte_grpcomm_coll_t *coll, size_t rank)
+{
+    return rank ^ coll->my_rank;
+}
+
+static prte_grpcomm_base_exchange_t rcd_exchange = {
+    .name = "rcd",
+    .tag = PRTE_RML_TAG_ALLGATHER_RCD,
+    .peer = rcd_peer,
+    .nblocks = rcd_nblocks,
+    .slot = rcd_slot
+};
+
+/**
+ * Initialize the module
+ */
+static int init(void)
+{
+    prte_grpcomm_base_exchange_init(&rcd_exchange);
+    return PRTE_SUCCESS;
+}
+
+/**
+ * Finalize the module
+ */
+static void finalize(void)
+{
+    prte_grpcomm_base_exchange_finalize(&rcd_exchange);
+    return;
+}
+
+static int allgather(prte_grpcomm_coll_t *coll,
+                     prte_buffer_t *buf, int mode)
+{
+    /* we cannot assign a context id without a root, and every
+     * daemon must reach the same decision here */
+    if ((PRTE_GRPCOMM_MODE_CID & mode) ||
+        coll->ndmns < (size_t)prte_grpcomm_rcd_min_daemons ||
+        0 != (coll->ndmns & (coll->ndmns - 1))) {
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    return prte_grpcomm_base_exchange_allgather(&rcd_exchange, coll, buf, mode);
+}
@@ -0,0 +1,54 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2014-2020 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include "src/mca/mca.h"
+
+#include "src/mca/grpcomm/base/base.h"
+#include "grpcomm_rcd.h"
+
+static int my_priority = 75;
+int prte_grpcomm_rcd_min_daemons = 64;
+static int rcd_query(prte_mca_base_module_t **module, int *priority);
+static int rcd_register(void);
+
+/*
+ * Struct of function pointers that need to be initialized
+ */
+prte_grpcomm_base_component_t prte_grpcomm_rcd_component = {
+    .base_version = {
+        PRTE_GRPCOMM_BASE_VERSION_3_0_0,
+
+        .mca_component_name = "rcd",
+        PRTE_MCA_BASE_MAKE_VERSION(component, PRTE_MAJOR_VERSION, PRTE_MINOR_VERSION,
+                                    PRTE_RELEASE_VERSION),
+        .mca_query_component = rcd_query,
+        .mca_register_component_params = rcd_register,
+    },
+    .base_data = {
+        /* The component is checkpoint ready */
+        PRTE_MCA_BASE_METADATA_PARAM_CHECKPOINT
+    },
+};
+
+static int rcd_register(void)
+{
+    return prte_grpcomm_base_exchange_register(&prte_grpcomm_rcd_component.base_version,
+                                               "recursive doubling", &my_priority,
+                                               &prte_grpcomm_rcd_min_daemons);
+}
+
+static int rcd_query(prte_mca_base_module_t **module, int *priority)
+{
+    return prte_grpcomm_base_exchange_query(&prte_grpcomm_rcd_module, my_priority,
+                                            module, priority);
+}
@@ -120,6 +120,7 @@ typedef struct {
     bool active;
     bool always_readable;
     prte_iof_sink_t *sink;
+    int32_t fragsize;           // #bytes to ask for on the next read
 } prte_iof_read_event_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_iof_read_event_t);
 
@@ -147,6 +148,9 @@ struct prte_iof_base_t {
     prte_iof_sink_t         *iof_write_stdout;
     prte_iof_sink_t         *iof_write_stderr;
     bool                    redirect_app_stderr_to_stdout;
+    int                     max_fragment;
+    bool                    coalesce;
+    int                     coalesce_tick;
 };
 typedef struct prte_iof_base_t prte_iof_base_t;
 
@@ -278,6 +282,22 @@ PRTE_EXPORT int prte_iof_base_write_output(const prte_process_name_t *name, prte
 PRTE_EXPORT void prte_iof_base_static_dump_output(prte_iof_read_event_t *rev);
 PRTE_EXPORT void prte_iof_base_write_handler(int fd, short event, void *cbdata);
 
+/* output forwarded to the HNP is carried as one or more frames, each
+ * holding the packed stream tag and source name followed by a raw
+ * byte count (uint32, network order) and that many bytes. The data
+ * bypasses the DSS so it can be read straight from a child's pipe
+ * into the outgoing message. If fd is valid, up to *numbytes are read
+ * from it - otherwise *numbytes are taken from src. On return,
+ * *numbytes holds the result of the read and, if it is not positive,
+ * nothing was added to the buffer */
+PRTE_EXPORT int prte_iof_base_frame_append(prte_buffer_t *buf, prte_iof_tag_t tag,
+                                           const prte_process_name_t *name,
+                                           int fd, const void *src,
+                                           int32_t *numbytes, unsigned char **data);
+/* get the data of the frame whose tag and name were just unpacked */
+PRTE_EXPORT int prte_iof_base_frame_data(prte_buffer_t *buf, unsigned char **data,
+                                         int32_t *numbytes);
+
 END_C_DECLS
 
 #endif /* MCA_IOF_BASE_H */
@@ -81,6 +81,36 @@ static int prte_iof_base_register(prte_mca_base_register_flag_t flags)
                                        PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                        &prte_iof_base.redirect_app_stderr_to_stdout);
 
+    /* largest read of a child's output - reads grow towards this
+     * while a pipe stays full and shrink again as it drains */
+    prte_iof_base.max_fragment = 256 * 1024;
+    (void) prte_mca_base_var_register("prte", "iof", "base", "max_fragment",
+                                       "Maximum number of bytes of a proc's output to read and forward at once (default: 256KiB)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prte_iof_base.max_fragment);
+    if (prte_iof_base.max_fragment < PRTE_IOF_BASE_MSG_MAX) {
+        prte_iof_base.max_fragment = PRTE_IOF_BASE_MSG_MAX;
+    }
+
+    /* combine the output of local procs into one message per tick */
+    prte_iof_base.coalesce = false;
+    (void) prte_mca_base_var_register("prte", "iof", "base", "coalesce",
+                                       "Forward the output of all local procs to the HNP in a single message per tick (default: false)",
+                                       PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prte_iof_base.coalesce);
+
+    prte_iof_base.coalesce_tick = 1000;
+    (void) prte_mca_base_var_register("prte", "iof", "base", "coalesce_tick",
+                                       "Time in microseconds to collect output before forwarding it when coalescing (default: 1000)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prte_iof_base.coalesce_tick);
+
     return PRTE_SUCCESS;
 }
 
@@ -220,6 +250,7 @@ static void prte_iof_base_read_event_construct(prte_iof_read_event_t* rev)
     rev->sink = NULL;
     rev->tv.tv_sec = 0;
     rev->tv.tv_usec = 0;
+    rev->fragsize = PRTE_IOF_BASE_MSG_MAX;
 }
 static void prte_iof_base_read_event_destruct(prte_iof_read_event_t* rev)
 {
@@ -35,6 +35,9 @@
 #endif
 #include <time.h>
 #include <errno.h>
+#ifdef HAVE_ARPA_INET_H
+#include <arpa/inet.h>
+#endif
 
 #include "src/util/output.h"
 
@@ -67,6 +70,21 @@ int prte_iof_base_write_output(const prte_process_name_t *name, prte_iof_tag_t s
                          PRTE_NAME_PRINT(name),
                          (NULL == channel) ? -1 : channel->fd));
 
+    /* output objects have a fixed size, so queue larger
+     * fragments a piece at a time */
+    if (PRTE_IOF_BASE_MSG_MAX < numbytes) {
+        for (i=0; i < numbytes; i += PRTE_IOF_BASE_MSG_MAX) {
+            num_buffered = prte_iof_base_write_output(name, stream, data + i,
+                                                      (numbytes - i < PRTE_IOF_BASE_MSG_MAX) ?
+                                                      numbytes - i : PRTE_IOF_BASE_MSG_MAX,
+                                                      channel);
+            if (num_buffered < 0) {
+                break;
+            }
+        }
+        return num_buffered;
+    }
+
     /* setup output object */
     output = PRTE_NEW(prte_iof_write_output_t);
 
@@ -385,3 +403,84 @@ void prte_iof_base_write_handler(int _fd, short event, void *cbdata)
 NEXT_CALL:
     PRTE_IOF_SINK_ACTIVATE(wev);
 }
+
+int prte_iof_base_frame_append(prte_buffer_t *buf, prte_iof_tag_t tag,
+                               const prte_process_name_t *name,
+                               int fd, const void *src,
+                               int32_t *numbytes, unsigned char **data)
+{
+    char *payload, *tmp;
+    int32_t start, used;
+    ssize_t n;
+    uint32_t nbo;
+    int rc, err;
+
+    start = buf->bytes_used;
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &tag, 1, PRTE_IOF_TAG)) ||
+        PRTE_SUCCESS != (rc = prte_dss.pack(buf, (void*)name, 1, PRTE_NAME))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* take the payload out of the buffer so the data can be
+     * placed directly behind what we just packed */
+    if (PRTE_SUCCESS != (rc = prte_dss.unload(buf, (void**)&payload, &used))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (NULL == (tmp = (char*)realloc(payload, used + sizeof(nbo) + *numbytes))) {
+        prte_dss.load(buf, payload, start);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    payload = tmp;
+
+    if (0 <= fd) {
+        n = read(fd, payload + used + sizeof(nbo), *numbytes);
+    } else {
+        memcpy(payload + used + sizeof(nbo), src, *numbytes);
+        n = *numbytes;
+    }
+    *numbytes = n;
+    if (n <= 0) {
+        /* nothing to send - drop the header, preserving
+         * errno so the caller can see why */
+        err = errno;
+        if (0 == start) {
+            free(payload);
+            payload = NULL;
+        }
+        prte_dss.load(buf, payload, start);
+        errno = err;
+        return PRTE_SUCCESS;
+    }
+
+    nbo = htonl((uint32_t)n);
+    memcpy(payload + used, &nbo, sizeof(nbo));
+    used += sizeof(nbo) + n;
+    prte_dss.load(buf, payload, used);
+    if (NULL != data) {
+        *data = (unsigned char*)payload + used - n;
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_iof_base_frame_data(prte_buffer_t *buf, unsigned char **data,
+                             int32_t *numbytes)
+{
+    size_t left;
+    uint32_t nbo;
+
+    left = buf->bytes_used - (buf->unpack_ptr - buf->base_ptr);
+    if (left < sizeof(nbo)) {
+        return PRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    memcpy(&nbo, buf->unpack_ptr, sizeof(nbo));
+    left -= sizeof(nbo);
+    if (left < ntohl(nbo)) {
+        return PRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    *data = (unsigned char*)buf->unpack_ptr + sizeof(nbo);
+    *numbytes = ntohl(nbo);
+    buf->unpack_ptr += sizeof(nbo) + *numbytes;
+    return PRTE_SUCCESS;
+}
@@ -125,6 +125,30 @@ prte_iof_base_setup_prefork(prte_iof_base_io_conf_t *opts)
 }
 
 
+int
+prte_iof_base_setup_pty(prte_iof_base_io_conf_t *opts)
+{
+    /* disable echo */
+    struct termios term_attrs;
+    if (tcgetattr(opts->p_stdout[1], &term_attrs) < 0) {
+        return PRTE_ERR_PIPE_SETUP_FAILURE;
+    }
+    term_attrs.c_lflag &= ~ (ECHO | ECHOE | ECHOK |
+                             ECHOCTL | ECHOKE | ECHONL);
+    term_attrs.c_iflag &= ~ (ICRNL | INLCR | ISTRIP | INPCK | IXON);
+    term_attrs.c_oflag &= ~ (
+#ifdef OCRNL
+                             /* OS X 10.3 does not have this
+                                value defined */
+                             OCRNL |
+#endif
+                             ONLCR);
+    if (tcsetattr(opts->p_stdout[1], TCSANOW, &term_attrs) == -1) {
+        return PRTE_ERR_PIPE_SETUP_FAILURE;
+    }
+    return PRTE_SUCCESS;
+}
+
 int
 prte_iof_base_setup_child(prte_iof_base_io_conf_t *opts, char ***env)
 {
@@ -139,23 +163,8 @@ prte_iof_base_setup_child(prte_iof_base_io_conf_t *opts, char ***env)
     }
 
     if (opts->usepty) {
-        /* disable echo */
-        struct termios term_attrs;
-        if (tcgetattr(opts->p_stdout[1], &term_attrs) < 0) {
-            return PRTE_ERR_PIPE_SETUP_FAILURE;
-        }
-        term_attrs.c_lflag &= ~ (ECHO | ECHOE | ECHOK |
-                                 ECHOCTL | ECHOKE | ECHONL);
-        term_attrs.c_iflag &= ~ (ICRNL | INLCR | ISTRIP | INPCK | IXON);
-        term_attrs.c_oflag &= ~ (
-#ifdef OCRNL
-                                 /* OS X 10.3 does not have this
-                                    value defined */
-                                 OCRNL |
-#endif
-                                 ONLCR);
-        if (tcsetattr(opts->p_stdout[1], TCSANOW, &term_attrs) == -1) {
-            return PRTE_ERR_PIPE_SETUP_FAILURE;
+        if (PRTE_SUCCESS != (ret = prte_iof_base_setup_pty(opts))) {
+            return ret;
         }
         ret = dup2(opts->p_stdout[1], fileno(stdout));
         if (ret < 0) {
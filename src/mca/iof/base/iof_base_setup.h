@@ -47,6 +47,13 @@ typedef struct prte_iof_base_io_conf_t prte_iof_base_io_conf_t;
  */
 PRTE_EXPORT int prte_iof_base_setup_prefork(prte_iof_base_io_conf_t *opts);
 
+/**
+ * Put the child's end of a pty into the mode the child expects.
+ * The terminal settings do not belong to a process, so this can
+ * be done by either the child or the parent
+ */
+PRTE_EXPORT int prte_iof_base_setup_pty(prte_iof_base_io_conf_t *opts);
+
 PRTE_EXPORT int prte_iof_base_setup_child(prte_iof_base_io_conf_t *opts,
                                             char ***env);
 
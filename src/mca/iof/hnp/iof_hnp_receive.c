@@ -67,7 +67,7 @@ void prte_iof_hnp_recv(int status, prte_process_name_t* sender,
                        void* cbdata)
 {
     prte_process_name_t origin, requestor;
-    unsigned char data[PRTE_IOF_BASE_MSG_MAX];
+    unsigned char *data;
     prte_iof_tag_t stream;
     int32_t count, numbytes;
     prte_iof_sink_t *sink, *next;
@@ -218,13 +218,14 @@ void prte_iof_hnp_recv(int status, prte_process_name_t* sender,
         goto CLEAN_RETURN;
     }
 
-    /* this must have come from a daemon forwarding output - unpack the data */
-    numbytes=PRTE_IOF_BASE_MSG_MAX;
-    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, data, &numbytes, PRTE_BYTE))) {
+    /* this must have come from a daemon forwarding output, possibly
+     * from several procs - get the data for each in turn. The data
+     * is used in place, so there is no need to copy it out */
+  NEXT_FRAME:
+    if (PRTE_SUCCESS != (rc = prte_iof_base_frame_data(buffer, &data, &numbytes))) {
         PRTE_ERROR_LOG(rc);
         goto CLEAN_RETURN;
     }
-    /* numbytes will contain the actual #bytes that were sent */
 
     PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s unpacked %d bytes from remote proc %s",
@@ -308,13 +309,9 @@ void prte_iof_hnp_recv(int status, prte_process_name_t* sender,
             }
         }
     }
-    /* if the user doesn't want a copy written to the screen, then we are done */
-    if (!proct->copy) {
-        return;
-    }
-
-    /* output this to our local output unless one of the sinks was exclusive */
-    if (!exclusive) {
+    /* output this to our local output unless the user doesn't want
+     * a copy written to the screen or one of the sinks was exclusive */
+    if (proct->copy && !exclusive) {
         if (PRTE_IOF_STDOUT & stream) {
             prte_iof_base_write_output(&origin, stream, data, numbytes, prte_iof_base.iof_write_stdout->wev);
         } else {
@@ -322,6 +319,21 @@ void prte_iof_hnp_recv(int status, prte_process_name_t* sender,
         }
     }
 
+    /* move on to the next frame, if any */
+    if (buffer->unpack_ptr < buffer->base_ptr + buffer->bytes_used) {
+        count = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &stream, &count, PRTE_IOF_TAG))) {
+            PRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+        count = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &origin, &count, PRTE_NAME))) {
+            PRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+        goto NEXT_FRAME;
+    }
+
  CLEAN_RETURN:
     return;
 }
@@ -337,6 +337,10 @@ static int finalize(void)
     }
     PRTE_DESTRUCT(&prte_iof_prted_component.procs);
 
+    /* send whatever is still held back for coalescing - this
+     * stops the flush timer and leaves nothing pending */
+    prte_iof_prted_flush();
+
     /* Cancel the RML receive */
     prte_rml.recv_cancel(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY);
     return PRTE_SUCCESS;
@@ -452,31 +456,24 @@ static int prted_output(const prte_process_name_t* peer,
                         const char *msg)
 {
     prte_buffer_t *buf;
+    int32_t numbytes;
     int rc;
 
     /* prep the buffer */
     buf = PRTE_NEW(prte_buffer_t);
 
-    /* pack the stream first - we do this so that flow control messages can
-     * consist solely of the tag
-     */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &source_tag, 1, PRTE_IOF_TAG))) {
+    /* frame the message as if it were output from the proc -
+     * ensure we include the NULL string terminator */
+    numbytes = strlen(msg) + 1;
+    if (PRTE_SUCCESS != (rc = prte_iof_base_frame_append(buf, source_tag, peer, -1, msg,
+                                                         &numbytes, NULL))) {
         PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(buf);
         return rc;
     }
 
-    /* pack name of process that gave us this data */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, peer, 1, PRTE_NAME))) {
-        PRTE_ERROR_LOG(rc);
-        return rc;
-    }
-
-    /* pack the data - for compatibility, we have to pack this as PRTE_BYTE,
-     * so ensure we include the NULL string terminator */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, msg, strlen(msg)+1, PRTE_BYTE))) {
-        PRTE_ERROR_LOG(rc);
-        return rc;
-    }
+    /* keep this behind any output already held back */
+    prte_iof_prted_flush();
 
     /* start non-blocking RML call to forward received data */
     PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
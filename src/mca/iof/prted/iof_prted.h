@@ -66,6 +66,10 @@ struct prte_iof_prted_component_t {
     prte_iof_base_component_t super;
     prte_list_t procs;
     bool xoff;
+    /* output held back for coalescing */
+    prte_buffer_t *pending;
+    prte_event_t flush_ev;
+    bool flush_active;
 };
 typedef struct prte_iof_prted_component_t prte_iof_prted_component_t;
 
@@ -78,6 +82,7 @@ void prte_iof_prted_recv(int status, prte_process_name_t* sender,
 
 void prte_iof_prted_read_handler(int fd, short event, void *data);
 void prte_iof_prted_send_xonxoff(prte_iof_tag_t tag);
+void prte_iof_prted_flush(void);
 
 END_C_DECLS
 
@@ -44,14 +44,50 @@
 
 #include "iof_prted.h"
 
+static void flush_cb(int fd, short args, void *cbdata)
+{
+    prte_iof_prted_component.flush_active = false;
+    prte_iof_prted_flush();
+}
+
+/* send any output held back for coalescing */
+void prte_iof_prted_flush(void)
+{
+    prte_buffer_t *buf;
+
+    if (prte_iof_prted_component.flush_active) {
+        prte_event_evtimer_del(&prte_iof_prted_component.flush_ev);
+        prte_iof_prted_component.flush_active = false;
+    }
+    if (NULL == (buf = prte_iof_prted_component.pending)) {
+        return;
+    }
+    prte_iof_prted_component.pending = NULL;
+    if (0 == buf->bytes_used) {
+        /* nothing was ever framed into it */
+        PRTE_RELEASE(buf);
+        return;
+    }
+
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s iof:prted:flush sending %d bytes to HNP",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int)buf->bytes_used));
+
+    if (0 > prte_rml.send_buffer_nb(PRTE_PROC_MY_HNP, buf, PRTE_RML_TAG_IOF_HNP,
+                                    prte_rml_send_callback, NULL)) {
+        PRTE_RELEASE(buf);
+    }
+}
+
 void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
 {
     prte_iof_read_event_t *rev = (prte_iof_read_event_t*)cbdata;
-    unsigned char data[PRTE_IOF_BASE_MSG_MAX];
+    unsigned char *data, scratch[PRTE_IOF_BASE_MSG_MAX];
     prte_buffer_t *buf=NULL;
-    int rc;
+    int rc, err;
     int32_t numbytes;
     prte_iof_proc_t *proct = (prte_iof_proc_t*)rev->proc;
+    struct timeval tv;
 
     PRTE_ACQUIRE_OBJECT(rev);
 
@@ -60,15 +96,47 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
      */
     fd = rev->fd;
 
-    /* read up to the fragment size */
-    numbytes = read(fd, data, sizeof(data));
-
     if (NULL == proct) {
         /* nothing we can do */
         PRTE_ERROR_LOG(PRTE_ERR_ADDRESSEE_UNKNOWN);
         return;
     }
 
+    if (proct->copy) {
+        /* read straight into the message we will forward - when
+         * coalescing, that is the one going out on the next tick */
+        if (prte_iof_base.coalesce) {
+            if (NULL == prte_iof_prted_component.pending) {
+                prte_iof_prted_component.pending = PRTE_NEW(prte_buffer_t);
+            }
+            buf = prte_iof_prted_component.pending;
+        } else {
+            buf = PRTE_NEW(prte_buffer_t);
+        }
+        /* read up to the fragment size */
+        numbytes = rev->fragsize;
+        if (PRTE_SUCCESS != (rc = prte_iof_base_frame_append(buf, rev->tag, &proct->name,
+                                                             fd, NULL, &numbytes, &data))) {
+            PRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+        if (numbytes <= 0 && buf == prte_iof_prted_component.pending &&
+            0 == buf->bytes_used) {
+            /* we created the pending frame for this read,
+             * but nothing arrived to go into it - keep errno
+             * for the checks below */
+            err = errno;
+            PRTE_RELEASE(buf);
+            prte_iof_prted_component.pending = NULL;
+            buf = NULL;
+            errno = err;
+        }
+    } else {
+        /* nothing goes to the HNP, so there is no message to build */
+        data = scratch;
+        numbytes = read(fd, scratch, sizeof(scratch));
+    }
+
     PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:prted:read handler read %d bytes from %s, fd %d",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -79,6 +147,9 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
             /* either we have a connection error or it was a non-blocking read */
             if (EAGAIN == errno || EINTR == errno) {
                 /* non-blocking, retry */
+                if (NULL != buf && buf != prte_iof_prted_component.pending) {
+                    PRTE_RELEASE(buf);
+                }
                 PRTE_IOF_READ_ACTIVATE(rev);
                 return;
             }
@@ -92,6 +163,23 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
         goto CLEAN_RETURN;
     }
 
+    /* grow the fragment while the proc keeps the pipe full,
+     * and shrink it again once the output slows down - output
+     * that stays local is always read in fixed-size pieces */
+    if (proct->copy) {
+        if (numbytes == rev->fragsize) {
+            if (rev->fragsize < prte_iof_base.max_fragment) {
+                rev->fragsize *= 2;
+                if (prte_iof_base.max_fragment < rev->fragsize) {
+                    rev->fragsize = prte_iof_base.max_fragment;
+                }
+            }
+        } else if (numbytes < rev->fragsize / 4 &&
+                   PRTE_IOF_BASE_MSG_MAX < rev->fragsize) {
+            rev->fragsize /= 2;
+        }
+    }
+
     /* see if the user wanted the output directed to files */
     if (NULL != rev->sink) {
         /* output to the corresponding file */
@@ -103,27 +191,21 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
         return;
     }
 
-    /* prep the buffer */
-    buf = PRTE_NEW(prte_buffer_t);
-
-    /* pack the stream first - we do this so that flow control messages can
-     * consist solely of the tag
-     */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &rev->tag, 1, PRTE_IOF_TAG))) {
-        PRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
-    }
-
-    /* pack name of process that gave us this data */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &proct->name, 1, PRTE_NAME))) {
-        PRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
-    }
-
-    /* pack the data - only pack the #bytes we read! */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &data, numbytes, PRTE_BYTE))) {
-        PRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+    if (buf == prte_iof_prted_component.pending) {
+        if (prte_iof_base.max_fragment <= (int)buf->bytes_used) {
+            /* don't let the frame grow without bound */
+            prte_iof_prted_flush();
+        } else if (!prte_iof_prted_component.flush_active) {
+            tv.tv_sec = prte_iof_base.coalesce_tick / 1000000;
+            tv.tv_usec = prte_iof_base.coalesce_tick % 1000000;
+            prte_event_evtimer_set(prte_event_base, &prte_iof_prted_component.flush_ev,
+                                   flush_cb, NULL);
+            prte_event_evtimer_add(&prte_iof_prted_component.flush_ev, &tv);
+            prte_iof_prted_component.flush_active = true;
+        }
+        /* re-add the event */
+        PRTE_IOF_READ_ACTIVATE(rev);
+        return;
     }
 
     /* start non-blocking RML call to forward received data */
@@ -140,6 +222,12 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
     return;
 
  CLEAN_RETURN:
+    if (NULL != buf && buf != prte_iof_prted_component.pending) {
+        PRTE_RELEASE(buf);
+    }
+    /* ensure any output still held back goes out ahead of
+     * the notice that this channel is complete */
+    prte_iof_prted_flush();
     /* must be an error, or zero bytes were read indicating that the
      * proc terminated this IOF channel - either way, release the
      * corresponding event. This deletes the read event and closes
@@ -161,8 +249,5 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
         /* this proc's iof is complete */
         PRTE_ACTIVATE_PROC_STATE(&proct->name, PRTE_PROC_STATE_IOF_COMPLETE);
     }
-    if (NULL != buf) {
-        PRTE_RELEASE(buf);
-    }
     return;
 }
@@ -373,7 +373,7 @@ static int do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
            always outputs a nice, single message indicating what
            happened
         */
-        if (PRTE_SUCCESS != (i = prte_iof_base_setup_child(&cd->opts, &cd->env))) {
+        if (PRTE_SUCCESS != (i = prte_iof_base_setup_child(&cd->opts, &cd->overrides))) {
             PRTE_ERROR_LOG(i);
             send_error_show_help(write_fd, 1,
                                  "help-prte-odls-alps.txt",
@@ -383,7 +383,7 @@ static int do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
         }
 
         /* now set any child-level controls such as binding */
-        prte_rtc.set(cd->jdata, cd->child, &cd->env, write_fd);
+        prte_rtc.set(cd->jdata, cd->child, &cd->overrides, write_fd);
 
     } else if (!PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
         /* tie stdin/out/err/internal to /dev/null */
@@ -397,6 +397,18 @@ static int do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
         }
     }
 
+    /* assemble the environment we exec with now that the IOF and rtc
+     * settings are in our overrides. The strings are shared with the
+     * app's base environment, so we never edit the result */
+    if (NULL == (cd->env = prte_odls_base_materialize_env(cd->appenv, cd->overrides))) {
+        send_error_show_help(write_fd, 1,
+                             "help-prte-odls-alps.txt",
+                             "syscall fail",
+                             prte_process_info.nodename, cd->app->app,
+                             "malloc", __FILE__, __LINE__);
+        /* Does not return */
+    }
+
     if (PRTE_SUCCESS != close_open_file_descriptors(write_fd, cd->opts)) {
         send_error_show_help(write_fd, 1, "help-prte-odls-alps.txt",
                              "close fds",
@@ -47,6 +47,7 @@
 #include <pmix_server.h>
 
 #include "prte_stdint.h"
+#include "src/class/prte_hash_table.h"
 #include "src/util/prte_environ.h"
 #include "src/util/argv.h"
 #include "src/util/os_dirpath.h"
@@ -161,6 +162,341 @@ static void setup_cbfunc(pmix_status_t status,
 
 }
 
+/* how the apps' environments are conveyed in a launch message */
+#define PRTE_ODLS_ENV_FULL      0   // each app carries its complete environment
+#define PRTE_ODLS_ENV_TEMPLATE  1   // ditto, and the first app's becomes the new template
+#define PRTE_ODLS_ENV_DELTA     2   // each app carries its differences from the template
+
+/* compare two "NAME=value" strings by name */
+static int env_namecmp(const char *a, const char *b)
+{
+    int ca, cb;
+
+    while (*a == *b && '\0' != *a && '=' != *a) {
+        ++a;
+        ++b;
+    }
+    ca = ('=' == *a) ? 0 : (unsigned char)*a;
+    cb = ('=' == *b) ? 0 : (unsigned char)*b;
+    return ca - cb;
+}
+
+static int env_sort_cmp(const void *a, const void *b)
+{
+    return env_namecmp(*(const char**)a, *(const char**)b);
+}
+
+/* return a copy of the environment sorted by name, or NULL
+ * if it contains the same name more than once */
+static char** env_sorted(char **env)
+{
+    char **sorted;
+    int32_t n, ne;
+
+    ne = prte_argv_count(env);
+    sorted = (char**)malloc((ne + 1) * sizeof(char*));
+    memcpy(sorted, env, ne * sizeof(char*));
+    sorted[ne] = NULL;
+    qsort(sorted, ne, sizeof(char*), env_sort_cmp);
+    for (n=1; n < ne; n++) {
+        if (0 == env_namecmp(sorted[n-1], sorted[n])) {
+            free(sorted);
+            return NULL;
+        }
+    }
+    return sorted;
+}
+
+/* make the given environment the template - returns false if
+ * it cannot serve as one */
+static bool set_env_template(char **env)
+{
+    char **sorted;
+
+    /* a delta cannot tell apart two entries of the same name */
+    if (NULL == (sorted = env_sorted(env))) {
+        return false;
+    }
+    free(sorted);
+    if (NULL != prte_odls_globals.env_template) {
+        prte_argv_free(prte_odls_globals.env_template);
+    }
+    prte_odls_globals.env_template = prte_argv_copy(env);
+    return true;
+}
+
+/* apply one entry of a delta - pass 0 removes the named
+ * variable, pass 1 sets a "NAME=value" entry, replacing
+ * the variable in place if it is already present */
+static void apply_env_entry(char ***env, int pass, char *str)
+{
+    char *eq;
+
+    if (0 == pass) {
+        prte_unsetenv(str, env);
+    } else if (NULL != (eq = strchr(str, '='))) {
+        *eq = '\0';
+        prte_setenv(str, eq + 1, true, env);
+        *eq = '=';
+    }
+}
+
+/* pack the names removed from the template and the entries added
+ * or changed by the given environment. Returns PRTE_ERR_TAKE_NEXT_OPTION,
+ * having packed nothing, if the environment is better sent whole */
+static int pack_env_delta(prte_buffer_t *buffer, char **env)
+{
+    char **sorted, **stmpl, **tmpl, **unset = NULL, **set = NULL, **rebuilt;
+    char **found, *name, *eq;
+    int32_t n, ne, nt, nunset, nset;
+    int rc = PRTE_SUCCESS;
+
+    if (NULL == (sorted = env_sorted(env))) {
+        /* duplicate names cannot be expressed as a delta */
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    tmpl = prte_odls_globals.env_template;
+    stmpl = env_sorted(tmpl);
+    ne = prte_argv_count(env);
+    nt = prte_argv_count(tmpl);
+    /* the entries that are new or changed, in the order given */
+    for (n=0; n < ne; n++) {
+        found = (char**)bsearch(&env[n], stmpl, nt, sizeof(char*), env_sort_cmp);
+        if (NULL == found || 0 != strcmp(*found, env[n])) {
+            prte_argv_append_nosize(&set, env[n]);
+        }
+    }
+    /* and the names that are gone */
+    for (n=0; n < nt; n++) {
+        if (NULL == bsearch(&tmpl[n], sorted, ne, sizeof(char*), env_sort_cmp)) {
+            name = strdup(tmpl[n]);
+            if (NULL != (eq = strchr(name, '='))) {
+                *eq = '\0';
+            }
+            prte_argv_append_nosize(&unset, name);
+            free(name);
+        }
+    }
+    free(sorted);
+    free(stmpl);
+
+    nunset = prte_argv_count(unset);
+    nset = prte_argv_count(set);
+    if (ne < 2 * (nunset + nset)) {
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+        goto done;
+    }
+    /* the delta only reproduces the environment if its variables
+     * are in the template's order with any new ones at the end -
+     * check by rebuilding it as the daemons will */
+    rebuilt = prte_argv_copy(tmpl);
+    for (n=0; n < nunset; n++) {
+        apply_env_entry(&rebuilt, 0, unset[n]);
+    }
+    for (n=0; n < nset; n++) {
+        apply_env_entry(&rebuilt, 1, set[n]);
+    }
+    if (ne != prte_argv_count(rebuilt)) {
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+    } else {
+        for (n=0; n < ne; n++) {
+            if (0 != strcmp(rebuilt[n], env[n])) {
+                rc = PRTE_ERR_TAKE_NEXT_OPTION;
+                break;
+            }
+        }
+    }
+    prte_argv_free(rebuilt);
+    if (PRTE_SUCCESS != rc) {
+        goto done;
+    }
+
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nunset, 1, PRTE_INT32)) ||
+        (0 < nunset && PRTE_SUCCESS != (rc = prte_dss.pack(buffer, unset, nunset, PRTE_STRING))) ||
+        PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nset, 1, PRTE_INT32)) ||
+        (0 < nset && PRTE_SUCCESS != (rc = prte_dss.pack(buffer, set, nset, PRTE_STRING)))) {
+        PRTE_ERROR_LOG(rc);
+    }
+
+  done:
+    prte_argv_free(unset);
+    prte_argv_free(set);
+    return rc;
+}
+
+/* unpack an environment delta and, if env is not NULL,
+ * apply it to a copy of the template */
+static int unpack_env_delta(prte_buffer_t *buffer, char ***env)
+{
+    char **newenv = NULL, *str;
+    int32_t k, n, cnt;
+    int rc, pass;
+
+    if (NULL != env) {
+        newenv = prte_argv_copy(prte_odls_globals.env_template);
+    }
+    /* the names to remove, then the entries to set */
+    for (pass=0; pass < 2; pass++) {
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &n, &cnt, PRTE_INT32))) {
+            PRTE_ERROR_LOG(rc);
+            prte_argv_free(newenv);
+            return rc;
+        }
+        for (k=0; k < n; k++) {
+            cnt = 1;
+            if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &str, &cnt, PRTE_STRING))) {
+                PRTE_ERROR_LOG(rc);
+                prte_argv_free(newenv);
+                return rc;
+            }
+            if (NULL != env) {
+                apply_env_entry(&newenv, pass, str);
+            }
+            free(str);
+        }
+    }
+    if (NULL != env) {
+        prte_argv_free(*env);
+        *env = newenv;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* launch messages held until we have the template they are based on */
+typedef struct {
+    prte_list_item_t super;
+    prte_buffer_t *buffer;
+} env_pending_t;
+static void epcon(env_pending_t *p)
+{
+    p->buffer = NULL;
+}
+static void epdes(env_pending_t *p)
+{
+    if (NULL != p->buffer) {
+        PRTE_RELEASE(p->buffer);
+    }
+}
+static PRTE_CLASS_INSTANCE(env_pending_t,
+                           prte_list_item_t,
+                           epcon, epdes);
+
+static prte_list_t env_pending;
+static bool env_requested = false;
+
+/* the HNP answers a daemon's request with its current template,
+ * and the daemon then retries the launches it was holding */
+static void env_template_recv(int status, prte_process_name_t* sender,
+                              prte_buffer_t* buffer, prte_rml_tag_t tag,
+                              void* cbdata)
+{
+    prte_buffer_t *reply;
+    prte_list_t held;
+    env_pending_t *p;
+    uint32_t epoch;
+    int32_t n, cnt;
+    char **env;
+    int rc;
+
+    if (PRTE_PROC_IS_MASTER) {
+        reply = PRTE_NEW(prte_buffer_t);
+        n = prte_argv_count(prte_odls_globals.env_template);
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(reply, &prte_odls_globals.env_epoch, 1, PRTE_UINT32)) ||
+            PRTE_SUCCESS != (rc = prte_dss.pack(reply, &n, 1, PRTE_INT32)) ||
+            (0 < n && PRTE_SUCCESS != (rc = prte_dss.pack(reply, prte_odls_globals.env_template, n, PRTE_STRING)))) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_RELEASE(reply);
+            return;
+        }
+        if (0 > (rc = prte_rml.send_buffer_nb(sender, reply, PRTE_RML_TAG_ENV_TEMPLATE,
+                                              prte_rml_send_callback, NULL))) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_RELEASE(reply);
+        }
+        return;
+    }
+
+    env_requested = false;
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &epoch, &cnt, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &n, &cnt, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        return;
+    }
+    env = (char**)calloc(n + 1, sizeof(char*));
+    if (0 < n) {
+        cnt = n;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, env, &cnt, PRTE_STRING))) {
+            PRTE_ERROR_LOG(rc);
+            prte_argv_free(env);
+            return;
+        }
+    }
+    if (set_env_template(env)) {
+        prte_odls_globals.env_epoch = epoch;
+    }
+    prte_argv_free(env);
+
+    /* retry the launches - any based on a still newer
+     * template will ask again */
+    PRTE_CONSTRUCT(&held, prte_list_t);
+    prte_list_join(&held, prte_list_get_end(&held), &env_pending);
+    while (NULL != (p = (env_pending_t*)prte_list_remove_first(&held))) {
+        prte_odls.launch_local_procs(p->buffer);
+        PRTE_RELEASE(p);
+    }
+    PRTE_LIST_DESTRUCT(&held);
+}
+
+/* hold a launch message until we have the template it is based
+ * on - the buffer is saved from start, where its unpacking began */
+static int request_env_template(prte_buffer_t *buffer, char *start)
+{
+    prte_buffer_t *req;
+    env_pending_t *p;
+    int rc;
+
+    p = PRTE_NEW(env_pending_t);
+    p->buffer = PRTE_NEW(prte_buffer_t);
+    buffer->unpack_ptr = start;
+    prte_dss.copy_payload(p->buffer, buffer);
+    prte_list_append(&env_pending, &p->super);
+
+    if (env_requested) {
+        return PRTE_SUCCESS;
+    }
+    req = PRTE_NEW(prte_buffer_t);
+    if (0 > (rc = prte_rml.send_buffer_nb(PRTE_PROC_MY_HNP, req, PRTE_RML_TAG_ENV_TEMPLATE,
+                                          prte_rml_send_callback, NULL))) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(req);
+        prte_list_remove_item(&env_pending, &p->super);
+        PRTE_RELEASE(p);
+        return rc;
+    }
+    env_requested = true;
+    return PRTE_SUCCESS;
+}
+
+void prte_odls_base_env_template_init(void)
+{
+    PRTE_CONSTRUCT(&env_pending, prte_list_t);
+    env_requested = false;
+    prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD, PRTE_RML_TAG_ENV_TEMPLATE,
+                            PRTE_RML_PERSISTENT, env_template_recv, NULL);
+}
+
+void prte_odls_base_env_template_finalize(void)
+{
+    prte_rml.recv_cancel(PRTE_NAME_WILDCARD, PRTE_RML_TAG_ENV_TEMPLATE);
+    PRTE_LIST_DESTRUCT(&env_pending);
+}
+
 /* IT IS CRITICAL THAT ANY CHANGE IN THE ORDER OF THE INFO PACKED IN
  * THIS FUNCTION BE REFLECTED IN THE CONSTRUCT_CHILD_LIST PARSER BELOW
 */
@@ -184,6 +520,12 @@ int prte_odls_base_default_get_add_procs_data(prte_buffer_t *buffer,
     prte_proc_t *pptr;
     uint32_t uid;
     uint32_t gid;
+    prte_app_context_t *app;
+    prte_buffer_t envdata, delta;
+    char ***envs = NULL;
+    int8_t tmode;
+    int32_t nenv;
+    bool newdaemons, first;
 
     /* get the job data pointer */
     if (NULL == (jdata = prte_get_job_data_object(job))) {
@@ -202,7 +544,8 @@ int prte_odls_base_default_get_add_procs_data(prte_buffer_t *buffer,
      * copy of all active jobs so the grpcomm collectives can
      * properly work should a proc from one of the other jobs
      * interact with this one */
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCHED_DAEMONS, NULL, PRTE_BOOL)) {
+    newdaemons = prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCHED_DAEMONS, NULL, PRTE_BOOL);
+    if (newdaemons) {
         flag = 1;
         prte_dss.pack(buffer, &flag, 1, PRTE_INT8);
         PRTE_CONSTRUCT(&jobdata, prte_buffer_t);
@@ -256,11 +599,94 @@ int prte_odls_base_default_get_add_procs_data(prte_buffer_t *buffer,
         prte_dss.pack(buffer, &flag, 1, PRTE_INT8);
     }
 
-    /* pack the job struct */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &jdata, 1, PRTE_JOB))) {
+    /* the daemons keep the environment of the first app of an earlier
+     * job as a template, so we only need to send each app's differences
+     * from it - unless new daemons have joined, which won't have it */
+    tmode = PRTE_ODLS_ENV_FULL;
+    PRTE_CONSTRUCT(&envdata, prte_buffer_t);
+    if (prte_odls_globals.use_env_template) {
+        if (NULL == prte_odls_globals.env_template || newdaemons) {
+            tmode = PRTE_ODLS_ENV_TEMPLATE;
+        } else {
+            tmode = PRTE_ODLS_ENV_DELTA;
+            first = true;
+            for (i=0; i < jdata->apps->size; i++) {
+                if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+                    continue;
+                }
+                PRTE_CONSTRUCT(&delta, prte_buffer_t);
+                rc = pack_env_delta(&delta, app->env);
+                if (PRTE_SUCCESS == rc) {
+                    flag = 1;
+                    prte_dss.pack(&envdata, &flag, 1, PRTE_INT8);
+                    prte_dss.copy_payload(&envdata, &delta);
+                } else if (PRTE_ERR_TAKE_NEXT_OPTION == rc && !first) {
+                    /* send this one whole */
+                    flag = 0;
+                    prte_dss.pack(&envdata, &flag, 1, PRTE_INT8);
+                    nenv = prte_argv_count(app->env);
+                    prte_dss.pack(&envdata, &nenv, 1, PRTE_INT32);
+                    if (0 < nenv) {
+                        prte_dss.pack(&envdata, app->env, nenv, PRTE_STRING);
+                    }
+                } else {
+                    /* the template no longer fits - replace it */
+                    tmode = PRTE_ODLS_ENV_TEMPLATE;
+                    PRTE_DESTRUCT(&delta);
+                    break;
+                }
+                PRTE_DESTRUCT(&delta);
+                first = false;
+            }
+        }
+        if (PRTE_ODLS_ENV_TEMPLATE == tmode) {
+            app = NULL;
+            for (i=0; NULL == app && i < jdata->apps->size; i++) {
+                app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i);
+            }
+            if (NULL != app && set_env_template(app->env)) {
+                ++prte_odls_globals.env_epoch;
+            } else {
+                tmode = PRTE_ODLS_ENV_FULL;
+            }
+        }
+    }
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &tmode, 1, PRTE_INT8)) ||
+        PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &prte_odls_globals.env_epoch, 1, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_DESTRUCT(&envdata);
+        return rc;
+    }
+
+    /* pack the job struct - without the environments if
+     * we are sending their differences */
+    if (PRTE_ODLS_ENV_DELTA == tmode) {
+        envs = (char***)calloc(jdata->apps->size, sizeof(char**));
+        for (i=0; i < jdata->apps->size; i++) {
+            if (NULL != (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+                envs[i] = app->env;
+                app->env = NULL;
+            }
+        }
+    }
+    rc = prte_dss.pack(buffer, &jdata, 1, PRTE_JOB);
+    if (NULL != envs) {
+        for (i=0; i < jdata->apps->size; i++) {
+            if (NULL != (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+                app->env = envs[i];
+            }
+        }
+        free(envs);
+    }
+    if (PRTE_SUCCESS != rc) {
         PRTE_ERROR_LOG(rc);
+        PRTE_DESTRUCT(&envdata);
         return rc;
     }
+    if (PRTE_ODLS_ENV_DELTA == tmode) {
+        prte_dss.copy_payload(buffer, &envdata);
+    }
+    PRTE_DESTRUCT(&envdata);
 
     if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PRTE_BOOL)) {
         /* compute and pack the ppn */
@@ -413,6 +839,10 @@ int prte_odls_base_default_construct_child_list(prte_buffer_t *buffer,
     prte_byte_object_t *bo;
     size_t m;
     prte_envar_t envt;
+    int8_t tmode;
+    uint32_t epoch;
+    int32_t k, nenv;
+    char **env, *start;
 
     PRTE_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
                          "%s odls:constructing child list",
@@ -420,6 +850,7 @@ int prte_odls_base_default_construct_child_list(prte_buffer_t *buffer,
 
     /* set a default response */
     *job = PRTE_JOBID_INVALID;
+    start = buffer->unpack_ptr;
     /* get the daemon job object */
     daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->jobid);
     PRTE_PMIX_CONSTRUCT_LOCK(&lock);
@@ -497,6 +928,31 @@ int prte_odls_base_default_construct_child_list(prte_buffer_t *buffer,
         PRTE_RELEASE(bptr);
     }
 
+    /* unpack how the environments were sent */
+    cnt=1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &tmode, &cnt, PRTE_INT8))) {
+        PRTE_ERROR_LOG(rc);
+        goto REPORT_ERROR;
+    }
+    cnt=1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &epoch, &cnt, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        goto REPORT_ERROR;
+    }
+    if (PRTE_ODLS_ENV_DELTA == tmode && !PRTE_PROC_IS_MASTER &&
+        (NULL == prte_odls_globals.env_template || epoch != prte_odls_globals.env_epoch)) {
+        /* we never got the template this is based upon - get
+         * it from the HNP and launch once it arrives */
+        PRTE_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                             "%s odls:construct_child_list lacks environment template %u - requesting it",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), epoch));
+        if (PRTE_SUCCESS != (rc = request_env_template(buffer, start))) {
+            goto REPORT_ERROR;
+        }
+        PRTE_PMIX_DESTRUCT_LOCK(&lock);
+        return PRTE_ERR_OP_IN_PROGRESS;
+    }
+
     /* unpack the job we are to launch */
     cnt=1;
     if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &jdata, &cnt, PRTE_JOB))) {
@@ -511,6 +967,54 @@ int prte_odls_base_default_construct_child_list(prte_buffer_t *buffer,
     }
     *job = jdata->jobid;
 
+    /* rebuild the environments - the HNP already has them, so
+     * it only needs to move past the data */
+    if (PRTE_ODLS_ENV_DELTA == tmode) {
+        for (n=0; n < jdata->apps->size; n++) {
+            if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, n))) {
+                continue;
+            }
+            cnt=1;
+            if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &flag, &cnt, PRTE_INT8))) {
+                PRTE_ERROR_LOG(rc);
+                goto REPORT_ERROR;
+            }
+            if (1 == flag) {
+                rc = unpack_env_delta(buffer, PRTE_PROC_IS_MASTER ? NULL : &app->env);
+                if (PRTE_SUCCESS != rc) {
+                    goto REPORT_ERROR;
+                }
+                continue;
+            }
+            /* this one was sent whole */
+            cnt=1;
+            if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, &nenv, &cnt, PRTE_INT32))) {
+                PRTE_ERROR_LOG(rc);
+                goto REPORT_ERROR;
+            }
+            env = (char**)calloc(nenv + 1, sizeof(char*));
+            if (0 < nenv) {
+                cnt = nenv;
+                if (PRTE_SUCCESS != (rc = prte_dss.unpack(buffer, env, &cnt, PRTE_STRING))) {
+                    PRTE_ERROR_LOG(rc);
+                    prte_argv_free(env);
+                    goto REPORT_ERROR;
+                }
+            }
+            prte_argv_free(app->env);
+            app->env = env;
+        }
+    } else if (PRTE_ODLS_ENV_TEMPLATE == tmode && !PRTE_PROC_IS_MASTER) {
+        /* the first app's environment is the new template */
+        app = NULL;
+        for (k=0; NULL == app && k < jdata->apps->size; k++) {
+            app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, k);
+        }
+        if (NULL != app && set_env_template(app->env)) {
+            prte_odls_globals.env_epoch = epoch;
+        }
+    }
+
     PRTE_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
                          "%s odls:construct_child_list unpacking data to launch job %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(*job)));
@@ -729,8 +1233,11 @@ int prte_odls_base_default_construct_child_list(prte_buffer_t *buffer,
         }
     }
 
-    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PRTE_BOOL)) {
-        /* compute and save bindings of local children */
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PRTE_BOOL) &&
+        !prte_rmaps_base_binding_on_hnp(jdata)) {
+        /* compute and save bindings of local children - if the HNP
+         * needed the bindings for every node, then it already
+         * computed them (including our own) when the job was mapped */
         if (PRTE_SUCCESS != (rc = prte_rmaps_base_compute_bindings(jdata))) {
             PRTE_ERROR_LOG(rc);
             goto REPORT_ERROR;
@@ -878,6 +1385,81 @@ static int compute_num_procs_alive(prte_jobid_t job)
     return num_procs_alive;
 }
 
+/* merge the app's environment into a copy of the launch environment.
+ * The result is indexed by name so the merge is linear in the size
+ * of the two rather than their product, and so that each child's
+ * settings can later be laid over it in the same way */
+static prte_odls_app_env_t *build_app_env(prte_app_context_t *app)
+{
+    prte_odls_app_env_t *ae;
+    char *eq;
+    void *val;
+    size_t len;
+    int i, n;
+
+    ae = PRTE_NEW(prte_odls_app_env_t);
+    ae->env = prte_argv_copy(prte_launch_environ);
+    n = prte_argv_count(ae->env);
+    prte_hash_table_init(&ae->index, n + prte_argv_count(app->env) + 1);
+    for (i=0; i < n; i++) {
+        if (NULL == (eq = strchr(ae->env[i], '='))) {
+            continue;
+        }
+        len = eq - ae->env[i];
+        /* as with prte_setenv, the first occurrence of a name wins */
+        if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(&ae->index, ae->env[i], len, &val)) {
+            prte_hash_table_set_value_ptr(&ae->index, ae->env[i], len, (void*)(intptr_t)i);
+        }
+    }
+    for (i=0; NULL != app->env && NULL != app->env[i]; i++) {
+        if (NULL == (eq = strchr(app->env[i], '='))) {
+            continue;
+        }
+        len = eq - app->env[i];
+        if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(&ae->index, app->env[i], len, &val)) {
+            free(ae->env[(intptr_t)val]);
+            ae->env[(intptr_t)val] = strdup(app->env[i]);
+        } else {
+            prte_hash_table_set_value_ptr(&ae->index, app->env[i], len, (void*)(intptr_t)n);
+            prte_argv_append_nosize(&ae->env, app->env[i]);
+            ++n;
+        }
+    }
+    ae->nenv = n;
+
+    return ae;
+}
+
+/* assemble a child's environment from the app's base environment
+ * and the child's own settings. Only the pointer array is allocated -
+ * the strings are borrowed from the two sources, which the caddy
+ * holds until the child has been launched. The result must therefore
+ * never be edited with prte_setenv - changes go into the overrides */
+char **prte_odls_base_materialize_env(prte_odls_app_env_t *ae, char **overrides)
+{
+    char **env, *eq;
+    void *val;
+    int32_t i, n;
+
+    n = ae->nenv;
+    env = (char**)malloc((n + prte_argv_count(overrides) + 1) * sizeof(char*));
+    if (NULL == env) {
+        return NULL;
+    }
+    memcpy(env, ae->env, n * sizeof(char*));
+    for (i=0; NULL != overrides && NULL != overrides[i]; i++) {
+        if (NULL != (eq = strchr(overrides[i], '=')) &&
+            PRTE_SUCCESS == prte_hash_table_get_value_ptr(&ae->index, overrides[i],
+                                                          eq - overrides[i], &val)) {
+            env[(intptr_t)val] = overrides[i];
+        } else {
+            env[n++] = overrides[i];
+        }
+    }
+    env[n] = NULL;
+    return env;
+}
+
 void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
 {
     prte_odls_spawn_caddy_t *cd = (prte_odls_spawn_caddy_t*)cbdata;
@@ -889,25 +1471,13 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
     prte_proc_state_t state;
     pmix_proc_t pproc;
     pmix_status_t ret;
-    char *ptr;
 
     PRTE_ACQUIRE_OBJECT(cd);
 
-    /* thread-protect common values */
-    cd->env = prte_argv_copy(prte_launch_environ);
-    if (NULL != app->env) {
-        for (i=0; NULL != app->env[i]; i++) {
-            /* find the '=' sign.
-             * strdup the env string to a tmp variable,
-             * since it is shared among apps.
-             */
-            char *tmp = strdup(app->env[i]);
-            ptr = strchr(tmp, '=');
-            *ptr = '\0';
-            ++ptr;
-            prte_setenv(tmp, ptr, true, &cd->env);
-            free(tmp);
-        }
+    /* the app's base environment is normally built once by the
+     * launcher, but restarts don't share one */
+    if (NULL == cd->appenv) {
+        cd->appenv = build_app_env(app);
     }
 
     /* ensure we clear any prior info regarding state or exit status in
@@ -918,7 +1488,7 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
 
     /* setup the pmix environment */
     PMIX_LOAD_PROCID(&pproc, child->job->nspace, child->name.vpid);
-    if (PMIX_SUCCESS != (ret = PMIx_server_setup_fork(&pproc, &cd->env))) {
+    if (PMIX_SUCCESS != (ret = PMIx_server_setup_fork(&pproc, &cd->overrides))) {
         PMIX_ERROR_LOG(ret);
         rc = PRTE_ERROR;
         state = PRTE_PROC_STATE_FAILED_TO_LAUNCH;
@@ -942,7 +1512,7 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
     /* setup the rest of the environment with the proc-specific items - these
      * will be overwritten for each child
      */
-    if (PRTE_SUCCESS != (rc = prte_schizo.setup_child(jobdat, child, app, &cd->env))) {
+    if (PRTE_SUCCESS != (rc = prte_schizo.setup_child(jobdat, child, app, &cd->overrides))) {
         PRTE_ERROR_LOG(rc);
         state = PRTE_PROC_STATE_FAILED_TO_LAUNCH;
         goto errorout;
@@ -1036,6 +1606,9 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
         goto errorout;
     }
 
+    if (NULL != cd->stats) {
+        prte_atomic_add_fetch_32(&cd->stats->nspawned, 1);
+    }
     PRTE_ACTIVATE_PROC_STATE(&child->name, PRTE_PROC_STATE_RUNNING);
     PRTE_RELEASE(cd);
     return;
@@ -1066,6 +1639,8 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
     char **argvptr;
     char *pathenv = NULL, *mpiexec_pathenv = NULL;
     char *full_search;
+    prte_odls_app_env_t *appenv = NULL;
+    prte_odls_spawn_stats_t *stats = NULL;
 
     PRTE_ACQUIRE_OBJECT(caddy);
 
@@ -1161,6 +1736,9 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
         }
     }
 
+    stats = PRTE_NEW(prte_odls_spawn_stats_t);
+    stats->job = jobdat->jobid;
+
     for (j=0; j < jobdat->apps->size; j++) {
         if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jobdat->apps, j))) {
             continue;
@@ -1328,6 +1906,9 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             goto GETOUT;
         }
 
+        /* build the environment common to all the procs for this app */
+        appenv = build_app_env(app);
+
         /* okay, now let's launch all the local procs for this app using the provided fork_local fn */
         for (idx=0; idx < prte_local_children->size; idx++) {
             if (NULL == (child = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, idx))) {
@@ -1398,6 +1979,10 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             cd->child = child;
             cd->fork_local = fork_local;
             cd->index_argv = index_argv;
+            PRTE_RETAIN(appenv);
+            cd->appenv = appenv;
+            PRTE_RETAIN(stats);
+            cd->stats = stats;
             /* setup any IOF */
             cd->opts.usepty = PRTE_ENABLE_PTY_SUPPORT;
 
@@ -1436,9 +2021,17 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             prte_event_active(&cd->ev, PRTE_EV_WRITE, 1);
 
         }
+        PRTE_RELEASE(appenv);
+        appenv = NULL;
     }
 
   GETOUT:
+    if (NULL != appenv) {
+        PRTE_RELEASE(appenv);
+    }
+    if (NULL != stats) {
+        PRTE_RELEASE(stats);
+    }
 
   ERROR_OUT:
     /* ensure we reset our working directory back to our default location  */
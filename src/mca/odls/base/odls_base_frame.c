@@ -116,6 +116,15 @@ static int prte_odls_base_register(prte_mca_base_register_flag_t flags)
                                        PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                        &prte_odls_globals.signal_direct_children_only);
 
+    prte_odls_globals.use_env_template = true;
+    (void) prte_mca_base_var_register("prte", "odls", "base", "env_template",
+                                       "Cache the launch environment on the daemons so that launch messages "
+                                       "only carry the differences from it",
+                                       PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prte_odls_globals.use_env_template);
+
     return PRTE_SUCCESS;
 }
 
@@ -206,6 +215,11 @@ static int prte_odls_base_close(void)
         PRTE_RELEASE(item);
     }
     PRTE_DESTRUCT(&prte_odls_globals.xterm_ranks);
+    prte_odls_base_env_template_finalize();
+    if (NULL != prte_odls_globals.env_template) {
+        prte_argv_free(prte_odls_globals.env_template);
+        prte_odls_globals.env_template = NULL;
+    }
 
     /* cleanup the global list of local children and job data */
     for (i=0; i < prte_local_children->size; i++) {
@@ -250,6 +264,7 @@ static int prte_odls_base_open(prte_mca_base_open_flag_t flags)
     /* initialize ODLS globals */
     PRTE_CONSTRUCT(&prte_odls_globals.xterm_ranks, prte_list_t);
     prte_odls_globals.xtermcmd = NULL;
+    prte_odls_base_env_template_init();
 
     /* ensure that SIGCHLD is unblocked as we need to capture it */
     if (0 != sigemptyset(&unblock)) {
@@ -340,9 +355,18 @@ static void sccon(prte_odls_spawn_caddy_t *p)
     p->wdir = NULL;
     p->argv = NULL;
     p->env = NULL;
+    p->overrides = NULL;
+    p->appenv = NULL;
+    p->stats = NULL;
 }
 static void scdes(prte_odls_spawn_caddy_t *p)
 {
+    if (NULL != p->appenv) {
+        PRTE_RELEASE(p->appenv);
+    }
+    if (NULL != p->stats) {
+        PRTE_RELEASE(p->stats);
+    }
     if (NULL != p->cmd) {
         free(p->cmd);
     }
@@ -353,9 +377,57 @@ static void scdes(prte_odls_spawn_caddy_t *p)
         prte_argv_free(p->argv);
     }
     if (NULL != p->env) {
-        prte_argv_free(p->env);
+        /* the strings are shared with appenv and overrides */
+        free(p->env);
+    }
+    if (NULL != p->overrides) {
+        prte_argv_free(p->overrides);
     }
 }
 PRTE_CLASS_INSTANCE(prte_odls_spawn_caddy_t,
                    prte_object_t,
                    sccon, scdes);
+
+static void aecon(prte_odls_app_env_t *p)
+{
+    p->env = NULL;
+    p->nenv = 0;
+    PRTE_CONSTRUCT(&p->index, prte_hash_table_t);
+}
+static void aedes(prte_odls_app_env_t *p)
+{
+    if (NULL != p->env) {
+        prte_argv_free(p->env);
+    }
+    PRTE_DESTRUCT(&p->index);
+}
+PRTE_CLASS_INSTANCE(prte_odls_app_env_t,
+                   prte_object_t,
+                   aecon, aedes);
+
+static void sscon(prte_odls_spawn_stats_t *p)
+{
+    p->job = PRTE_JOBID_INVALID;
+    p->nspawned = 0;
+    gettimeofday(&p->start, NULL);
+}
+static void ssdes(prte_odls_spawn_stats_t *p)
+{
+    struct timeval now;
+    double secs;
+
+    if (0 == p->nspawned) {
+        return;
+    }
+    gettimeofday(&now, NULL);
+    secs = (double)(now.tv_sec - p->start.tv_sec) +
+           (double)(now.tv_usec - p->start.tv_usec) / 1000000.0;
+    prte_output_verbose(1, prte_odls_base_framework.framework_output,
+                        "%s odls:launch spawned %d procs of job %s in %.6f sec (%.1f procs/sec)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int)p->nspawned,
+                        PRTE_JOBID_PRINT(p->job), secs,
+                        (0.0 < secs) ? (double)p->nspawned / secs : 0.0);
+}
+PRTE_CLASS_INSTANCE(prte_odls_spawn_stats_t,
+                   prte_object_t,
+                   sscon, ssdes);
@@ -34,9 +34,14 @@
 #include "prte_config.h"
 #include "types.h"
 
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
 #include "src/class/prte_list.h"
 #include "src/class/prte_pointer_array.h"
 #include "src/class/prte_bitmap.h"
+#include "src/class/prte_hash_table.h"
 #include "src/dss/dss_types.h"
 
 #include "src/mca/iof/base/iof_base_setup.h"
@@ -69,6 +74,11 @@ typedef struct {
     int next_base;                  // counter to load-level thread use
     bool signal_direct_children_only;
     prte_lock_t lock;
+    /* environment template shared by the HNP and daemons so
+     * launch messages need only carry each app's differences */
+    bool use_env_template;
+    uint32_t env_epoch;             // version of the current template
+    char **env_template;            // NULL if none
 } prte_odls_globals_t;
 
 PRTE_EXPORT extern prte_odls_globals_t prte_odls_globals;
@@ -88,9 +98,36 @@ prte_odls_base_default_construct_child_list(prte_buffer_t *data,
 
 PRTE_EXPORT void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata);
 
+/* serve and request the environment template
+ * that launch messages are relative to */
+PRTE_EXPORT void prte_odls_base_env_template_init(void);
+PRTE_EXPORT void prte_odls_base_env_template_finalize(void);
+
 /* define a function that will fork a local proc */
 typedef int (*prte_odls_base_fork_local_proc_fn_t)(void *cd);
 
+/* the launch environment merged with an app's own environment -
+ * built once per app and shared, read-only, by the threads spawning
+ * its children. Each child keeps only its own settings and points
+ * at these strings for everything else */
+typedef struct {
+    prte_object_t super;
+    char **env;
+    int32_t nenv;
+    prte_hash_table_t index;        // name -> position in env
+} prte_odls_app_env_t;
+PRTE_CLASS_DECLARATION(prte_odls_app_env_t);
+
+/* tracks the children dispatched by a local launch - the spawn
+ * rate is reported when the last of them lets go of it */
+typedef struct {
+    prte_object_t super;
+    prte_jobid_t job;
+    prte_atomic_int32_t nspawned;
+    struct timeval start;
+} prte_odls_spawn_stats_t;
+PRTE_CLASS_DECLARATION(prte_odls_spawn_stats_t);
+
 /* define an object for fork/exec the local proc */
 typedef struct {
     prte_object_t super;
@@ -98,16 +135,24 @@ typedef struct {
     char *cmd;
     char *wdir;
     char **argv;
-    char **env;
+    char **env;                         // array only, built in the child - the strings belong to appenv/overrides
+    char **overrides;                   // settings specific to this child
     prte_job_t *jdata;
     prte_app_context_t *app;
     prte_proc_t *child;
     bool index_argv;
     prte_iof_base_io_conf_t opts;
     prte_odls_base_fork_local_proc_fn_t fork_local;
+    prte_odls_app_env_t *appenv;        // shared base environment, if any
+    prte_odls_spawn_stats_t *stats;     // launch this child is part of, if any
 } prte_odls_spawn_caddy_t;
 PRTE_CLASS_DECLARATION(prte_odls_spawn_caddy_t);
 
+/* assemble the environment a child execs with from the shared
+ * base environment and the child's overrides */
+PRTE_EXPORT char **prte_odls_base_materialize_env(prte_odls_app_env_t *ae,
+                                                  char **overrides);
+
 /* define an object for starting local launch */
 typedef struct {
     prte_object_t object;
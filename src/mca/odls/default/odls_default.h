@@ -45,6 +45,9 @@ int prte_odls_default_component_query(prte_mca_base_module_t **module, int *prio
  * ODLS Default module
  */
 extern prte_odls_base_module_t prte_odls_default_module;
+
+/* launch children with posix_spawn where it can do all the child setup */
+extern bool prte_odls_default_use_posix_spawn;
 PRTE_MODULE_EXPORT extern prte_odls_base_component_t prte_odls_default_component;
 
 END_C_DECLS
@@ -45,6 +45,10 @@
 #include "src/mca/odls/base/odls_private.h"
 #include "src/mca/odls/default/odls_default.h"
 
+static int odls_default_component_register(void);
+
+bool prte_odls_default_use_posix_spawn = false;
+
 /*
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
@@ -64,6 +68,7 @@ prte_odls_base_component_t prte_odls_default_component = {
         .mca_open_component = prte_odls_default_component_open,
         .mca_close_component = prte_odls_default_component_close,
         .mca_query_component = prte_odls_default_component_query,
+        .mca_register_component_params = odls_default_component_register,
     },
     .base_data = {
         /* The component is checkpoint ready */
@@ -72,6 +77,20 @@ prte_odls_base_component_t prte_odls_default_component = {
 };
 
 
+static int odls_default_component_register(void)
+{
+    prte_mca_base_component_t *c = &prte_odls_default_component.version;
+
+    prte_odls_default_use_posix_spawn = false;
+    (void) prte_mca_base_component_var_register(c, "use_posix_spawn",
+                                                "Launch local procs with posix_spawn instead of fork, avoiding the copy of the daemon's "
+                                                "address space for every child (procs that need setup posix_spawn cannot express are still forked)",
+                                                PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                                PRTE_INFO_LVL_9,
+                                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                &prte_odls_default_use_posix_spawn);
+    return PRTE_SUCCESS;
+}
 
 int prte_odls_default_component_open(void)
 {
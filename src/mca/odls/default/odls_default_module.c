@@ -109,6 +109,10 @@
 #include <dirent.h>
 #endif
 #include <ctype.h>
+#if HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP && HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+#include <spawn.h>
+#define PRTE_ODLS_DEFAULT_HAVE_SPAWN 1
+#endif
 #ifdef HAVE_SYS_PTRACE_H
 #include <sys/ptrace.h>
 #endif
@@ -120,6 +124,8 @@
 #include "src/util/show_help.h"
 #include "src/util/sys_limits.h"
 #include "src/util/fd.h"
+#include "src/util/printf.h"
+#include "src/util/string_copy.h"
 
 #include "src/util/show_help.h"
 #include "src/runtime/prte_wait.h"
@@ -293,7 +299,9 @@ static void send_error_show_help(int fd, int exit_status,
     write_help_msg(fd, &msg, file, topic, ap);
     va_end(ap);
 
-    exit(exit_status);
+    /* use _exit so we neither run the daemon's atexit handlers nor
+     * flush its inherited stdio buffers */
+    _exit(exit_status);
 }
 
 static int do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
@@ -326,7 +334,7 @@ static int do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
            happened
         */
         if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
-            if (PRTE_SUCCESS != (i = prte_iof_base_setup_child(&cd->opts, &cd->env))) {
+            if (PRTE_SUCCESS != (i = prte_iof_base_setup_child(&cd->opts, &cd->overrides))) {
                 PRTE_ERROR_LOG(i);
                 send_error_show_help(write_fd, 1,
                                      "help-prte-odls-default.txt",
@@ -337,7 +345,7 @@ static int do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
         }
 
         /* now set any child-level controls such as binding */
-        prte_rtc.set(cd->jdata, cd->child, &cd->env, write_fd);
+        prte_rtc.set(cd->jdata, cd->child, &cd->overrides, write_fd);
 
     } else if (!PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
         /* tie stdin/out/err/internal to /dev/null */
@@ -351,6 +359,18 @@ static int do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
         }
     }
 
+    /* assemble the environment we exec with now that the IOF and rtc
+     * settings are in our overrides. The strings are shared with the
+     * app's base environment, so we never edit the result */
+    if (NULL == (cd->env = prte_odls_base_materialize_env(cd->appenv, cd->overrides))) {
+        send_error_show_help(write_fd, 1,
+                             "help-prte-odls-default.txt",
+                             "syscall fail",
+                             prte_process_info.nodename, cd->app->app,
+                             "malloc", __FILE__, __LINE__);
+        /* Does not return */
+    }
+
     /* close all open file descriptors w/ exception of stdin/stdout/stderr,
        the pipe used for the IOF INTERNAL messages, and the pipe up to
        the parent. */
@@ -605,6 +625,190 @@ static int do_parent(prte_odls_spawn_caddy_t *cd, int read_fd)
 }
 
 
+#if PRTE_ODLS_DEFAULT_HAVE_SPAWN
+/* posix_spawn can only stand in for do_child when everything the
+ * child would do for itself can be done by us or described as a
+ * spawn action. Anything else is left to the fork path, which also
+ * reports any problems the usual way. If the child is to be bound,
+ * the cpuset it is to be bound to is returned */
+static bool spawn_capable(prte_odls_spawn_caddy_t *cd, hwloc_cpuset_t *cpuset)
+{
+    const char *cpu_bitmap;
+    struct stat buf;
+
+    *cpuset = NULL;
+    if (!prte_odls_default_use_posix_spawn || NULL == cd->child ||
+        NULL == cd->argv || NULL == cd->appenv) {
+        return false;
+    }
+#if PRTE_HAVE_STOP_ON_EXEC
+    if (prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_STOP_ON_EXEC, NULL, PRTE_BOOL)) {
+        return false;
+    }
+#endif
+    /* only a plain cpu binding can be passed on - reports, memory
+     * policies and unbinding procs from a bound daemon need the rtc */
+    if (prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_REPORT_BINDINGS, NULL, PRTE_BOOL) ||
+        PRTE_HWLOC_BASE_MAP_NONE != prte_hwloc_base_map) {
+        return false;
+    }
+    cpu_bitmap = (const char*)prte_get_attribute_ptr(&cd->child->attributes, PRTE_PROC_CPU_BITMAP, PRTE_STRING);
+    if (NULL == cpu_bitmap || 0 == strlen(cpu_bitmap)) {
+        if (NULL != prte_daemon_cores) {
+            return false;
+        }
+    } else {
+        *cpuset = hwloc_bitmap_alloc();
+        if (0 != hwloc_bitmap_list_sscanf(*cpuset, cpu_bitmap)) {
+            hwloc_bitmap_free(*cpuset);
+            *cpuset = NULL;
+            return false;
+        }
+    }
+    /* posix_spawn cannot tell us that it was the chdir that failed */
+    if (NULL != cd->wdir &&
+        (0 != stat(cd->wdir, &buf) || !S_ISDIR(buf.st_mode) || 0 != access(cd->wdir, X_OK))) {
+        if (NULL != *cpuset) {
+            hwloc_bitmap_free(*cpuset);
+            *cpuset = NULL;
+        }
+        return false;
+    }
+    return true;
+}
+
+/* do what do_child would do, but from here. Returns
+ * PRTE_ERR_TAKE_NEXT_OPTION if the child should be forked instead */
+static int spawn_local_proc(prte_odls_spawn_caddy_t *cd, hwloc_cpuset_t cpuset)
+{
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    hwloc_cpuset_t saved = NULL;
+    prte_proc_t *child = cd->child;
+    sigset_t sigs;
+    short flags;
+    pid_t pid;
+    int rc;
+    char dir[MAXPATHLEN], *msg;
+    struct stat stats;
+
+    if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT) && cd->opts.usepty &&
+        PRTE_SUCCESS != prte_iof_base_setup_pty(&cd->opts)) {
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    /* neither the IOF nor the rtc add anything to the
+     * overrides for the children we spawn */
+    if (NULL == (cd->env = prte_odls_base_materialize_env(cd->appenv, cd->overrides))) {
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* connect the stdio the way prte_iof_base_setup_child does */
+    posix_spawn_file_actions_init(&actions);
+    if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
+        if (cd->opts.connect_stdin) {
+            posix_spawn_file_actions_adddup2(&actions, cd->opts.p_stdin[0], fileno(stdin));
+        } else {
+            posix_spawn_file_actions_addopen(&actions, fileno(stdin), "/dev/null", O_RDONLY, 0);
+        }
+        posix_spawn_file_actions_adddup2(&actions, cd->opts.p_stdout[1], fileno(stdout));
+        if (prte_iof_base.redirect_app_stderr_to_stdout) {
+            posix_spawn_file_actions_adddup2(&actions, cd->opts.p_stdout[1], fileno(stderr));
+        } else {
+            posix_spawn_file_actions_adddup2(&actions, cd->opts.p_stderr[1], fileno(stderr));
+        }
+    }
+    /* this also closes the pipe ends that aren't the child's */
+    posix_spawn_file_actions_addclosefrom_np(&actions, 3);
+    if (NULL != cd->wdir) {
+        posix_spawn_file_actions_addchdir_np(&actions, cd->wdir);
+    }
+
+    /* reset the signals do_child resets, and unblock them all */
+    posix_spawnattr_init(&attr);
+    flags = POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK;
+#if HAVE_SETPGID
+    flags |= POSIX_SPAWN_SETPGROUP;
+    posix_spawnattr_setpgroup(&attr, 0);
+#endif
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGTERM);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGHUP);
+    sigaddset(&sigs, SIGPIPE);
+    sigaddset(&sigs, SIGCHLD);
+    sigaddset(&sigs, SIGTRAP);
+    posix_spawnattr_setsigdefault(&attr, &sigs);
+    sigemptyset(&sigs);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+    posix_spawnattr_setflags(&attr, flags);
+
+    /* the child inherits the binding of the thread that spawns it */
+    if (NULL != cpuset) {
+        saved = hwloc_bitmap_alloc();
+        if (0 != hwloc_get_cpubind(prte_hwloc_topology, saved, HWLOC_CPUBIND_THREAD) ||
+            0 != hwloc_set_cpubind(prte_hwloc_topology, cpuset, HWLOC_CPUBIND_THREAD)) {
+            rc = PRTE_ERR_TAKE_NEXT_OPTION;
+            goto cleanup;
+        }
+    }
+
+    rc = posix_spawn(&pid, cd->cmd, &actions, &attr, cd->argv, cd->env);
+
+    if (NULL != saved) {
+        hwloc_set_cpubind(prte_hwloc_topology, saved, HWLOC_CPUBIND_THREAD);
+    }
+
+    /* the child has its own copies of its ends of the pipes */
+    if (cd->opts.connect_stdin) {
+        close(cd->opts.p_stdin[0]);
+    }
+    close(cd->opts.p_stdout[1]);
+    if( !prte_iof_base.redirect_app_stderr_to_stdout ) {
+        close(cd->opts.p_stderr[1]);
+    }
+
+    if (0 != rc) {
+        /* report it as do_child reports a failed execve */
+        if (NULL != cd->wdir) {
+            prte_string_copy(dir, cd->wdir, sizeof(dir));
+        } else {
+            (void) getcwd(dir, sizeof(dir));
+        }
+        if (ENOENT == rc && 0 == stat(cd->app->app, &stats)) {
+            prte_asprintf(&msg, "%s has a bad interpreter on the first line.",
+                          cd->app->app);
+        } else {
+            msg = strdup(strerror(rc));
+        }
+        prte_show_help("help-prte-odls-default.txt", "execve error", true,
+                       prte_process_info.nodename, dir, cd->app->app, msg);
+        free(msg);
+        child->state = PRTE_PROC_STATE_FAILED_TO_START;
+        PRTE_FLAG_UNSET(child, PRTE_PROC_FLAG_ALIVE);
+        rc = PRTE_ERR_FAILED_TO_START;
+        goto cleanup;
+    }
+
+    child->pid = pid;
+    child->state = PRTE_PROC_STATE_RUNNING;
+    PRTE_FLAG_SET(child, PRTE_PROC_FLAG_ALIVE);
+    rc = PRTE_SUCCESS;
+
+  cleanup:
+    if (NULL != saved) {
+        hwloc_bitmap_free(saved);
+    }
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+        /* do_child builds its own */
+        free(cd->env);
+        cd->env = NULL;
+    }
+    return rc;
+}
+#endif
+
 /**
  *  Fork/exec the specified processes
  */
@@ -614,6 +818,20 @@ static int odls_default_fork_local_proc(void *cdptr)
     int p[2];
     pid_t pid;
     prte_proc_t *child = cd->child;
+#if PRTE_ODLS_DEFAULT_HAVE_SPAWN
+    hwloc_cpuset_t cpuset;
+    int rc;
+
+    if (spawn_capable(cd, &cpuset)) {
+        rc = spawn_local_proc(cd, cpuset);
+        if (NULL != cpuset) {
+            hwloc_bitmap_free(cpuset);
+        }
+        if (PRTE_ERR_TAKE_NEXT_OPTION != rc) {
+            return rc;
+        }
+    }
+#endif
 
     /* A pipe is used to communicate between the parent and child to
        indicate whether the exec ultimately succeeded or failed.  The
@@ -96,6 +96,9 @@ typedef uint8_t prte_daemon_cmd_flag_t;
 /* pass node info */
 #define PRTE_DAEMON_PASS_NODE_INFO_CMD      (prte_daemon_cmd_flag_t) 35
 
+/* incremental update to the node map */
+#define PRTE_DAEMON_NIDMAP_UPDATE_CMD       (prte_daemon_cmd_flag_t) 36
+
 /*
  * Struct written up the pipe from the child to the parent.
  */
@@ -87,6 +87,7 @@ prte_oob_tcp_module_t prte_oob_tcp_module = {
  * Local utility functions
  */
 static void recv_handler(int sd, short flags, void* user);
+static void ping_peer(int fd, short args, void *cbdata);
 
 /* Called by prte_oob_tcp_accept() and connection_handler() on
  * a socket that has been accepted.  This call finishes processing the
@@ -139,13 +140,27 @@ static void ping(const prte_process_name_t *proc)
         return;
     }
 
+    /* the connection state belongs to the thread
+     * progressing this peer, so check it there */
+    PRTE_ACTIVATE_TCP_CONN_STATE(peer, ping_peer);
+}
+
+static void ping_peer(int fd, short args, void *cbdata)
+{
+    prte_oob_tcp_conn_op_t *op = (prte_oob_tcp_conn_op_t*)cbdata;
+    prte_oob_tcp_peer_t *peer;
+
+    PRTE_ACQUIRE_OBJECT(op);
+    peer = op->peer;
+
     /* if we are already connected, there is nothing to do */
     if (MCA_OOB_TCP_CONNECTED == peer->state) {
         prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s:[%s:%d] already connected to peer %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             __FILE__, __LINE__,
-                            PRTE_NAME_PRINT(proc));
+                            PRTE_NAME_PRINT(&peer->name));
+        PRTE_RELEASE(op);
         return;
     }
 
@@ -156,13 +171,15 @@ static void ping(const prte_process_name_t *proc)
                             "%s:[%s:%d] already connecting to peer %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             __FILE__, __LINE__,
-                            PRTE_NAME_PRINT(proc));
+                            PRTE_NAME_PRINT(&peer->name));
+        PRTE_RELEASE(op);
         return;
     }
 
-    /* attempt the connection */
+    /* attempt the connection - we are already on the
+     * peer's event base, so there is no need to shift */
     peer->state = MCA_OOB_TCP_CONNECTING;
-    PRTE_ACTIVATE_TCP_CONN_STATE(peer, prte_oob_tcp_peer_try_connect);
+    prte_oob_tcp_peer_try_connect(fd, args, op);
 }
 
 static void send_nb(prte_rml_send_t *msg)
@@ -197,34 +214,38 @@ static void send_nb(prte_rml_send_t *msg)
                         PRTE_NAME_PRINT(&msg->dst), msg->tag, msg->seq_num,
                         PRTE_NAME_PRINT(&peer->name));
 
-    /* add the msg to the hop's send queue */
-    if (MCA_OOB_TCP_CONNECTED == peer->state) {
-        prte_output_verbose(2, prte_oob_base_framework.framework_output,
-                            "%s tcp:send_nb: already connected to %s - queueing for send",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            PRTE_NAME_PRINT(&peer->name));
-        MCA_OOB_TCP_QUEUE_SEND(msg, peer);
-        return;
-    }
+    /* add the msg to the hop's send queue - whether to send it
+     * now or connect first is decided on the peer's own event
+     * base, as only that thread may look at the peer's state */
+    MCA_OOB_TCP_QUEUE_SEND(msg, peer);
+}
 
-    /* add the message to the queue for sending after the
-     * connection is formed
-     */
-    MCA_OOB_TCP_QUEUE_PENDING(msg, peer);
-
-    if (MCA_OOB_TCP_CONNECTING != peer->state &&
-        MCA_OOB_TCP_CONNECT_ACK != peer->state) {
-        /* we have to initiate the connection - again, we do not
-         * want to block while the connection is created.
-         * So throw us into an event that will create
-         * the connection via a mini-state-machine :-)
-         */
-        prte_output_verbose(2, prte_oob_base_framework.framework_output,
-                            "%s tcp:send_nb: initiating connection to %s",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            PRTE_NAME_PRINT(&peer->name));
-        peer->state = MCA_OOB_TCP_CONNECTING;
-        PRTE_ACTIVATE_TCP_CONN_STATE(peer, prte_oob_tcp_peer_try_connect);
+/*
+ * Look at the connect-ack header on a newly accepted socket
+ * without removing it. The peer sends the header in one piece,
+ * but it may not all have arrived yet
+ */
+static bool peek_header(int sd, prte_oob_tcp_hdr_t *hdr)
+{
+    ssize_t rc;
+
+    while (1) {
+        rc = recv(sd, hdr, sizeof(prte_oob_tcp_hdr_t), MSG_PEEK);
+        if (sizeof(prte_oob_tcp_hdr_t) == rc) {
+            return true;
+        }
+        if (0 == rc) {
+            /* remote closed connection */
+            return false;
+        }
+        if (rc < 0 && prte_socket_errno != EINTR &&
+            prte_socket_errno != EAGAIN && prte_socket_errno != EWOULDBLOCK) {
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                                "%s tcp:peek_header: recv() failed: %s (%d)",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                strerror(prte_socket_errno), prte_socket_errno);
+            return false;
+        }
     }
 }
 
@@ -238,7 +259,7 @@ static void send_nb(prte_rml_send_t *msg)
 static void recv_handler(int sd, short flg, void *cbdata)
 {
     prte_oob_tcp_conn_op_t *op = (prte_oob_tcp_conn_op_t*)cbdata;
-    int flags;
+    int flags, rc;
     prte_oob_tcp_hdr_t hdr;
     prte_oob_tcp_peer_t *peer;
 
@@ -248,14 +269,49 @@ static void recv_handler(int sd, short flg, void *cbdata)
                         "%s:tcp:recv:handler called",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
+    /* if the peer's socket events are progressed by one of our
+     * own threads, then the handshake has to be completed by that
+     * thread as it changes the peer's socket, state and events.
+     * Peek at the header to see who is calling - the peer table
+     * itself is only maintained here */
+    if (NULL == op->peer && 0 < prte_oob_tcp_component.num_threads) {
+        if (!peek_header(sd, &hdr)) {
+            CLOSE_THE_SOCKET(sd);
+            goto cleanup;
+        }
+        MCA_OOB_TCP_HDR_NTOH(&hdr);
+        if (MCA_OOB_TCP_IDENT == hdr.type) {
+            if (NULL == (peer = prte_oob_tcp_peer_get(&hdr.origin))) {
+                CLOSE_THE_SOCKET(sd);
+                goto cleanup;
+            }
+            if (peer->ev_base != prte_event_base) {
+                op->peer = peer;
+                prte_event_set(peer->ev_base, &op->ev, sd,
+                               PRTE_EV_READ, recv_handler, op);
+                prte_event_set_priority(&op->ev, PRTE_MSG_PRI);
+                PRTE_POST_OBJECT(op);
+                prte_event_add(&op->ev, 0);
+                return;
+            }
+        }
+    }
+
     /* get the handshake */
-    if (PRTE_SUCCESS != prte_oob_tcp_peer_recv_connect_ack(NULL, sd, &hdr)) {
+    if (NULL != op->peer) {
+        rc = prte_oob_tcp_peer_accept_connect_ack(op->peer, sd, &hdr);
+    } else {
+        rc = prte_oob_tcp_peer_recv_connect_ack(NULL, sd, &hdr);
+    }
+    if (PRTE_SUCCESS != rc) {
         goto cleanup;
     }
 
     /* finish processing ident */
     if (MCA_OOB_TCP_IDENT == hdr.type) {
-        if (NULL == (peer = prte_oob_tcp_peer_lookup(&hdr.origin))) {
+        if (NULL != op->peer) {
+            peer = op->peer;
+        } else if (NULL == (peer = prte_oob_tcp_peer_lookup(&hdr.origin))) {
             /* should never happen */
             prte_oob_tcp_peer_close(peer);
             goto cleanup;
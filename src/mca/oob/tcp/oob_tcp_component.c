@@ -64,6 +64,7 @@
 #include "src/mca/prteif/prteif.h"
 #include "src/util/net.h"
 #include "src/util/argv.h"
+#include "src/util/printf.h"
 #include "src/class/prte_hash_table.h"
 #include "src/class/prte_list.h"
 #include "src/event/event-internal.h"
@@ -156,6 +157,14 @@ static int tcp_component_open(void)
     prte_oob_tcp_component.ipv6conns = NULL;
     prte_oob_tcp_component.ipv6ports = NULL;
     prte_oob_tcp_component.if_masks = NULL;
+    prte_oob_tcp_component.ev_bases = NULL;
+    prte_oob_tcp_component.ev_threads = NULL;
+    prte_oob_tcp_component.hdr_bytes = 0;
+    prte_oob_tcp_component.hdr_bytes_saved = 0;
+    prte_oob_tcp_component.num_reads = 0;
+    prte_oob_tcp_component.num_writes = 0;
+    prte_oob_tcp_component.msgs_recvd = 0;
+    prte_oob_tcp_component.msgs_sent = 0;
 
     /* if_include and if_exclude need to be mutually exclusive */
     if (PRTE_SUCCESS !=
@@ -455,6 +464,62 @@ static int tcp_component_register(void)
                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                           &prte_oob_tcp_component.max_recon_attempts);
 
+    prte_oob_tcp_component.compact_hdr = true;
+    (void)prte_mca_base_component_var_register(component, "compact_hdr",
+                                          "Offer peers a compact message header that omits the routed module string (used only if both sides agree)",
+                                          PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                          PRTE_INFO_LVL_5,
+                                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prte_oob_tcp_component.compact_hdr);
+
+    prte_oob_tcp_component.batch_sends = false;
+    (void)prte_mca_base_component_var_register(component, "batch_sends",
+                                          "Coalesce messages queued for a peer into a single writev",
+                                          PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                          PRTE_INFO_LVL_5,
+                                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prte_oob_tcp_component.batch_sends);
+
+    prte_oob_tcp_component.batch_max_bytes = 65536;
+    (void)prte_mca_base_component_var_register(component, "batch_max_bytes",
+                                          "Maximum number of bytes to coalesce into a single writev (ignored unless batch_sends is set)",
+                                          PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PRTE_INFO_LVL_5,
+                                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prte_oob_tcp_component.batch_max_bytes);
+
+    prte_oob_tcp_component.batch_delay = 0;
+    (void)prte_mca_base_component_var_register(component, "batch_delay",
+                                          "Time (in usec) to hold the first message of a burst so others can be coalesced with it (ignored unless batch_sends is set)",
+                                          PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PRTE_INFO_LVL_5,
+                                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prte_oob_tcp_component.batch_delay);
+
+    prte_oob_tcp_component.read_ahead_size = 0;
+    (void)prte_mca_base_component_var_register(component, "read_ahead_size",
+                                          "Size (in bytes) of a per-peer read-ahead buffer that lets a single read pick up several messages. Each message is still copied out of it into its own allocation, and a pending partial message is moved to the front when it cannot be completed in place (0 => read each header and body separately)",
+                                          PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PRTE_INFO_LVL_5,
+                                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prte_oob_tcp_component.read_ahead_size);
+    /* the buffer must at least hold a full header */
+    if (0 < prte_oob_tcp_component.read_ahead_size &&
+        prte_oob_tcp_component.read_ahead_size < (int)sizeof(prte_oob_tcp_hdr_t)) {
+        prte_oob_tcp_component.read_ahead_size = sizeof(prte_oob_tcp_hdr_t);
+    }
+
+    prte_oob_tcp_component.num_threads = 0;
+    (void)prte_mca_base_component_var_register(component, "num_threads",
+                                          "Number of dedicated progress threads for OOB socket events - peers are distributed across them by vpid (0 => progress on the main event base)",
+                                          PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PRTE_INFO_LVL_5,
+                                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prte_oob_tcp_component.num_threads);
+    if (prte_oob_tcp_component.num_threads < 0) {
+        prte_oob_tcp_component.num_threads = 0;
+    }
+
     return PRTE_SUCCESS;
 }
 
@@ -643,6 +708,27 @@ static int component_startup(void)
                         "%s TCP STARTUP",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
+    /* setup the progress threads, if requested */
+    if (0 < prte_oob_tcp_component.num_threads) {
+        int i;
+        char *tmp;
+
+        prte_oob_tcp_component.ev_bases =
+            (prte_event_base_t**)malloc(prte_oob_tcp_component.num_threads * sizeof(prte_event_base_t*));
+        for (i=0; i < prte_oob_tcp_component.num_threads; i++) {
+            prte_asprintf(&tmp, "PRTE-OOB-TCP-%d", i);
+            prte_oob_tcp_component.ev_bases[i] = prte_progress_thread_init(tmp);
+            prte_argv_append_nosize(&prte_oob_tcp_component.ev_threads, tmp);
+            free(tmp);
+            if (NULL == prte_oob_tcp_component.ev_bases[i]) {
+                /* the failure was already logged - fall back to
+                 * the threads we have */
+                prte_oob_tcp_component.num_threads = i;
+                break;
+            }
+        }
+    }
+
     /* if we are a daemon/HNP,
      * then it is possible that someone else may initiate a
      * connection to us. In these cases, we need to start the
@@ -679,6 +765,14 @@ static void component_shutdown(void)
                         "no hnp or not active");
     }
 
+    /* stop the progress threads so nothing fires while
+     * we release the peers */
+    if (NULL != prte_oob_tcp_component.ev_threads) {
+        for (i=0; NULL != prte_oob_tcp_component.ev_threads[i]; i++) {
+            prte_progress_thread_pause(prte_oob_tcp_component.ev_threads[i]);
+        }
+    }
+
     /* release all peers from the hash table */
     rc = prte_hash_table_get_first_key_uint64(&prte_oob_tcp_component.peers, &key,
                                               (void **)&peer, &node);
@@ -697,6 +791,33 @@ static void component_shutdown(void)
     /* cleanup listen event list */
     PRTE_LIST_DESTRUCT(&prte_oob_tcp_component.listeners);
 
+    /* now that the peers are gone, release the progress threads */
+    if (NULL != prte_oob_tcp_component.ev_threads) {
+        for (i=0; NULL != prte_oob_tcp_component.ev_threads[i]; i++) {
+            prte_progress_thread_finalize(prte_oob_tcp_component.ev_threads[i]);
+        }
+        prte_argv_free(prte_oob_tcp_component.ev_threads);
+        prte_oob_tcp_component.ev_threads = NULL;
+    }
+    if (NULL != prte_oob_tcp_component.ev_bases) {
+        free(prte_oob_tcp_component.ev_bases);
+        prte_oob_tcp_component.ev_bases = NULL;
+    }
+    prte_oob_tcp_component.num_threads = 0;
+
+    prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                        "%s TCP HEADER BYTES SENT %lu SAVED %lu",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        (unsigned long)prte_oob_tcp_component.hdr_bytes,
+                        (unsigned long)prte_oob_tcp_component.hdr_bytes_saved);
+    prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                        "%s TCP MSGS SENT %lu IN %lu WRITES RECVD %lu IN %lu READS",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        (unsigned long)prte_oob_tcp_component.msgs_sent,
+                        (unsigned long)prte_oob_tcp_component.num_writes,
+                        (unsigned long)prte_oob_tcp_component.msgs_recvd,
+                        (unsigned long)prte_oob_tcp_component.num_reads);
+
     prte_output_verbose(2, prte_oob_base_framework.framework_output,
                         "%s TCP SHUTDOWN done",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -940,6 +1061,7 @@ static int component_set_addr(prte_process_name_t *peer,
                 pr = PRTE_NEW(prte_oob_tcp_peer_t);
                 pr->name.jobid = peer->jobid;
                 pr->name.vpid = peer->vpid;
+                PRTE_OOB_TCP_PEER_SET_BASE(pr);
                 prte_output_verbose(20, prte_oob_base_framework.framework_output,
                                     "%s SET_PEER ADDING PEER %s",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -970,7 +1092,7 @@ static int component_set_addr(prte_process_name_t *peer,
                                 PRTE_NAME_PRINT(peer),
                                 (NULL == host) ? "NULL" : host,
                                 (NULL == ports) ? "NULL" : ports);
-            prte_list_append(&pr->addrs, &maddr->super);
+            PRTE_ACTIVATE_TCP_ADDR_OP(pr, maddr, prte_oob_tcp_component_add_addr);
 
             found = true;
         }
@@ -1004,6 +1126,17 @@ static bool component_is_reachable(prte_process_name_t *peer)
     return true;
 }
 
+void prte_oob_tcp_component_add_addr(int fd, short args, void *cbdata)
+{
+    prte_oob_tcp_addr_op_t *aop = (prte_oob_tcp_addr_op_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(aop);
+
+    prte_list_append(&aop->peer->addrs, &aop->addr->super);
+    aop->addr = NULL;
+    PRTE_RELEASE(aop);
+}
+
 void prte_oob_tcp_component_set_module(int fd, short args, void *cbdata)
 {
     prte_oob_tcp_peer_op_t *pop = (prte_oob_tcp_peer_op_t*)cbdata;
@@ -1329,12 +1462,18 @@ static void peer_cons(prte_oob_tcp_peer_t *peer)
     peer->active_addr = NULL;
     peer->state = MCA_OOB_TCP_UNCONNECTED;
     peer->num_retries = 0;
+    peer->ev_base = prte_event_base;
+    peer->compact_hdr = false;
     PRTE_CONSTRUCT(&peer->send_queue, prte_list_t);
     peer->send_msg = NULL;
     peer->recv_msg = NULL;
     peer->send_ev_active = false;
     peer->recv_ev_active = false;
     peer->timer_ev_active = false;
+    peer->batch_ev_active = false;
+    peer->rbuf = NULL;
+    peer->rbuf_start = 0;
+    peer->rbuf_end = 0;
 }
 static void peer_des(prte_oob_tcp_peer_t *peer)
 {
@@ -1350,6 +1489,12 @@ static void peer_des(prte_oob_tcp_peer_t *peer)
     if (peer->timer_ev_active) {
         prte_event_del(&peer->timer_event);
     }
+    if (peer->batch_ev_active) {
+        prte_event_del(&peer->batch_event);
+    }
+    if (NULL != peer->rbuf) {
+        free(peer->rbuf);
+    }
     if (0 <= peer->sd) {
         prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s CLOSING SOCKET %d",
@@ -1393,6 +1538,24 @@ PRTE_CLASS_INSTANCE(prte_oob_tcp_peer_op_t,
                    prte_object_t,
                    pop_cons, pop_des);
 
+static void aop_cons(prte_oob_tcp_addr_op_t *aop)
+{
+    aop->peer = NULL;
+    aop->addr = NULL;
+}
+static void aop_des(prte_oob_tcp_addr_op_t *aop)
+{
+    if (NULL != aop->addr) {
+        PRTE_RELEASE(aop->addr);
+    }
+    if (NULL != aop->peer) {
+        PRTE_RELEASE(aop->peer);
+    }
+}
+PRTE_CLASS_INSTANCE(prte_oob_tcp_addr_op_t,
+                   prte_object_t,
+                   aop_cons, aop_des);
+
 PRTE_CLASS_INSTANCE(prte_oob_tcp_msg_op_t,
                    prte_object_t,
                    NULL, NULL);
@@ -38,6 +38,7 @@
 #include "src/class/prte_pointer_array.h"
 #include "src/class/prte_hash_table.h"
 #include "src/event/event-internal.h"
+#include "src/threads/threads.h"
 
 #include "src/mca/oob/oob.h"
 #include "oob_tcp.h"
@@ -89,10 +90,25 @@ typedef struct {
     int                keepalive_intvl;        /**< time between keepalives, in seconds */
     int                retry_delay;            /**< time to wait before retrying connection */
     int                max_recon_attempts;     /**< maximum number of times to attempt connect before giving up (-1 for never) */
+    bool               compact_hdr;            /**< offer the compact message header to peers */
+    bool               batch_sends;            /**< coalesce queued sends into a single writev */
+    int                batch_max_bytes;        /**< max bytes to coalesce into one writev */
+    int                batch_delay;            /**< usec to hold the first msg of a burst */
+    int                read_ahead_size;        /**< size of per-peer read-ahead buffer (0 => read msgs individually) */
+    int                num_threads;            /**< number of dedicated progress threads (0 => use prte_event_base) */
+    prte_event_base_t  **ev_bases;             /**< event bases of the progress threads */
+    char               **ev_threads;           /**< names of the progress threads */
+    prte_atomic_size_t hdr_bytes;              /**< header bytes put on the wire for user msgs */
+    prte_atomic_size_t hdr_bytes_saved;        /**< header bytes saved by the compact format */
+    prte_atomic_size_t num_reads;              /**< read syscalls on established connections */
+    prte_atomic_size_t num_writes;             /**< write syscalls on established connections */
+    prte_atomic_size_t msgs_recvd;             /**< user msgs received */
+    prte_atomic_size_t msgs_sent;              /**< user msgs sent */
 } prte_oob_tcp_component_t;
 
 PRTE_MODULE_EXPORT extern prte_oob_tcp_component_t prte_oob_tcp_component;
 
+PRTE_MODULE_EXPORT void prte_oob_tcp_component_add_addr(int fd, short args, void *cbdata);
 PRTE_MODULE_EXPORT void prte_oob_tcp_component_set_module(int fd, short args, void *cbdata);
 PRTE_MODULE_EXPORT void prte_oob_tcp_component_lost_connection(int fd, short args, void *cbdata);
 PRTE_MODULE_EXPORT void prte_oob_tcp_component_failed_to_connect(int fd, short args, void *cbdata);
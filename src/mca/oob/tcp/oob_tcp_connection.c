@@ -94,6 +94,8 @@ static int tcp_peer_send_blocking(int sd, void* data, size_t size);
 static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t* peer, int sd,
                                    void* data, size_t size);
 static void tcp_peer_connected(prte_oob_tcp_peer_t* peer);
+static int tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr, bool is_new,
+                                     int sd, prte_oob_tcp_hdr_t *dhdr);
 
 static int tcp_peer_create_socket(prte_oob_tcp_peer_t* peer, sa_family_t family)
 {
@@ -516,11 +518,17 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t* peer)
     char *msg;
     prte_oob_tcp_hdr_t hdr;
     uint16_t ack_flag = htons(1);
+    uint8_t flags = 0;
     size_t sdsize, offset = 0;
 
     prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s SEND CONNECT ACK", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
+    /* advertise the optional features we support */
+    if (prte_oob_tcp_component.compact_hdr) {
+        flags |= MCA_OOB_TCP_FLAG_COMPACT_HDR;
+    }
+
     /* load the header */
     hdr.origin = *PRTE_PROC_MY_NAME;
     hdr.dst = peer->name;
@@ -530,7 +538,7 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t* peer)
     memset(hdr.routed, 0, PRTE_MAX_RTD_SIZE+1);
 
     /* payload size */
-    sdsize = sizeof(ack_flag) + strlen(prte_version_string) + 1;
+    sdsize = sizeof(ack_flag) + strlen(prte_version_string) + 1 + sizeof(flags);
     hdr.nbytes = sdsize;
     MCA_OOB_TCP_HDR_HTON(&hdr);
 
@@ -548,6 +556,8 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t* peer)
     offset += sizeof(ack_flag);
     memcpy(msg + offset, prte_version_string, strlen(prte_version_string) + 1);
     offset += strlen(prte_version_string)+1;
+    memcpy(msg + offset, &flags, sizeof(flags));
+    offset += sizeof(flags);
 
     /* send it */
     if (PRTE_SUCCESS != tcp_peer_send_blocking(peer->sd, msg, sdsize)) {
@@ -620,7 +630,7 @@ static void tcp_peer_event_init(prte_oob_tcp_peer_t* peer)
 {
     if (peer->sd >= 0) {
         assert(!peer->send_ev_active && !peer->recv_ev_active);
-        prte_event_set(prte_event_base,
+        prte_event_set(peer->ev_base,
                        &peer->recv_event,
                        peer->sd,
                        PRTE_EV_READ|PRTE_EV_PERSIST,
@@ -632,7 +642,7 @@ static void tcp_peer_event_init(prte_oob_tcp_peer_t* peer)
             peer->recv_ev_active = false;
         }
 
-        prte_event_set(prte_event_base,
+        prte_event_set(peer->ev_base,
                        &peer->send_event,
                        peer->sd,
                        PRTE_EV_WRITE|PRTE_EV_PERSIST,
@@ -827,17 +837,62 @@ static bool retry(prte_oob_tcp_peer_t* peer, int sd, bool fatal)
 }
 
 
+/*
+ * Find the peer that a connection request came from, creating it
+ * if this is the first we have heard of it. The peer table is only
+ * maintained by prte_event_base, so this must be called from there
+ */
+prte_oob_tcp_peer_t* prte_oob_tcp_peer_get(const prte_process_name_t *name)
+{
+    prte_oob_tcp_peer_t *peer;
+    uint64_t *ui64;
+
+    if (NULL != (peer = prte_oob_tcp_peer_lookup(name))) {
+        return peer;
+    }
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                        "%s prte_oob_tcp_recv_connect: connection from new peer",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+    peer = PRTE_NEW(prte_oob_tcp_peer_t);
+    peer->name = *name;
+    PRTE_OOB_TCP_PEER_SET_BASE(peer);
+    peer->state = MCA_OOB_TCP_ACCEPTING;
+    ui64 = (uint64_t*)(&peer->name);
+    if (PRTE_SUCCESS != prte_hash_table_set_value_uint64(&prte_oob_tcp_component.peers, (*ui64), peer)) {
+        PRTE_RELEASE(peer);
+        return NULL;
+    }
+    return peer;
+}
+
 int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
                                       int sd, prte_oob_tcp_hdr_t *dhdr)
+{
+    return tcp_peer_recv_connect_ack(pr, (NULL == pr), sd, dhdr);
+}
+
+/*
+ * Complete the handshake on a connection that peer initiated. Used
+ * in place of prte_oob_tcp_peer_recv_connect_ack when the peer was
+ * already looked up on prte_event_base so that the handshake could
+ * be shifted to the thread that progresses the peer's socket events
+ */
+int prte_oob_tcp_peer_accept_connect_ack(prte_oob_tcp_peer_t* peer,
+                                        int sd, prte_oob_tcp_hdr_t *dhdr)
+{
+    return tcp_peer_recv_connect_ack(peer, true, sd, dhdr);
+}
+
+static int tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr, bool is_new,
+                                     int sd, prte_oob_tcp_hdr_t *dhdr)
 {
     char *msg;
     char *version;
     size_t offset = 0;
     prte_oob_tcp_hdr_t hdr;
     prte_oob_tcp_peer_t *peer;
-    uint64_t *ui64;
     uint16_t ack_flag;
-    bool is_new = (NULL == pr);
+    uint8_t flags = 0;
 
     prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s RECV CONNECT ACK FROM %s ON SOCKET %d",
@@ -847,7 +902,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
     peer = pr;
     /* get the header */
     if (tcp_peer_recv_blocking(peer, sd, &hdr, sizeof(prte_oob_tcp_hdr_t))) {
-        if (NULL != peer) {
+        if (NULL != peer && !is_new) {
             /* If the peer state is CONNECT_ACK, then we were waiting for
              * the connection to be ack'd
              */
@@ -906,20 +961,9 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
 
     /* if we don't already have it, get the peer */
     if (NULL == peer) {
-        peer = prte_oob_tcp_peer_lookup(&hdr.origin);
-        if (NULL == peer) {
-            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
-                                "%s prte_oob_tcp_recv_connect: connection from new peer",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-            peer = PRTE_NEW(prte_oob_tcp_peer_t);
-            peer->name = hdr.origin;
-            peer->state = MCA_OOB_TCP_ACCEPTING;
-            ui64 = (uint64_t*)(&peer->name);
-            if (PRTE_SUCCESS != prte_hash_table_set_value_uint64(&prte_oob_tcp_component.peers, (*ui64), peer)) {
-                PRTE_RELEASE(peer);
-                CLOSE_THE_SOCKET(sd);
-                return PRTE_ERR_OUT_OF_RESOURCE;
-            }
+        if (NULL == (peer = prte_oob_tcp_peer_get(&hdr.origin))) {
+            CLOSE_THE_SOCKET(sd);
+            return PRTE_ERR_OUT_OF_RESOURCE;
         }
     } else {
         /* compare the peers name to the expected value */
@@ -1029,6 +1073,11 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
         free(msg);
         return PRTE_ERR_CONNECTION_REFUSED;
     }
+    /* get the features the peer offers */
+    if (offset < hdr.nbytes) {
+        memcpy(&flags, msg + offset, sizeof(flags));
+        offset += sizeof(flags);
+    }
     free(msg);
 
     prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
@@ -1036,6 +1085,18 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* pr,
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(&peer->name));
 
+    /* use the compact header only if we both offered it - don't
+     * touch a connection that is already up */
+    if (MCA_OOB_TCP_CONNECTED != peer->state) {
+        peer->compact_hdr = prte_oob_tcp_component.compact_hdr &&
+                            (flags & MCA_OOB_TCP_FLAG_COMPACT_HDR);
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                            "%s using %s header with %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            peer->compact_hdr ? "compact" : "full",
+                            PRTE_NAME_PRINT(&peer->name));
+    }
+
     /* if the requestor wanted the header returned, then they
      * will complete their processing
      */
@@ -1107,6 +1168,11 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
     /* release the socket */
     close(peer->sd);
     peer->sd = -1;
+    /* the header format is renegotiated on the next connection */
+    peer->compact_hdr = false;
+    /* discard any partial data read from the old socket */
+    peer->rbuf_start = 0;
+    peer->rbuf_end = 0;
 
     /* if we were CONNECTING, then we need to mark the address as
      * failed and cycle back to try the next address */
@@ -1132,6 +1198,10 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
         prte_event_del(&peer->send_event);
         peer->send_ev_active = false;
     }
+    if (peer->batch_ev_active) {
+        prte_event_del(&peer->batch_event);
+        peer->batch_ev_active = false;
+    }
 
     /* inform the component-level that we have lost a connection so
      * it can decide what to do about it.
@@ -62,7 +62,7 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
                             PRTE_NAME_PRINT((&(p)->name)));             \
         cop = PRTE_NEW(prte_oob_tcp_conn_op_t);                           \
         cop->peer = (p);                                                \
-        PRTE_THREADSHIFT(cop, prte_event_base, (cbfunc), PRTE_MSG_PRI);    \
+        PRTE_THREADSHIFT(cop, (p)->ev_base, (cbfunc), PRTE_MSG_PRI);       \
     } while(0);
 
 #define PRTE_ACTIVATE_TCP_ACCEPT_STATE(s, a, cbfunc)            \
@@ -86,7 +86,7 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
                             PRTE_NAME_PRINT((&(p)->name)));             \
         cop = PRTE_NEW(prte_oob_tcp_conn_op_t);                           \
         cop->peer = (p);                                                \
-        prte_event_evtimer_set(prte_event_base,                            \
+        prte_event_evtimer_set((p)->ev_base,                            \
                                &cop->ev,                                \
                                (cbfunc), cop);                          \
         PRTE_POST_OBJECT(cop);                                          \
@@ -99,6 +99,9 @@ PRTE_MODULE_EXPORT bool prte_oob_tcp_peer_accept(prte_oob_tcp_peer_t* peer);
 PRTE_MODULE_EXPORT void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t* peer);
 PRTE_MODULE_EXPORT int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t* peer,
                                                            int sd, prte_oob_tcp_hdr_t *dhdr);
+PRTE_MODULE_EXPORT int prte_oob_tcp_peer_accept_connect_ack(prte_oob_tcp_peer_t* peer,
+                                                            int sd, prte_oob_tcp_hdr_t *dhdr);
+PRTE_MODULE_EXPORT prte_oob_tcp_peer_t* prte_oob_tcp_peer_get(const prte_process_name_t *name);
 PRTE_MODULE_EXPORT void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer);
 
 #endif /* _MCA_OOB_TCP_CONNECTION_H_ */
@@ -67,6 +67,24 @@ typedef struct {
     /* routed module to be used */
     char routed[PRTE_MAX_RTD_SIZE+1];
 } prte_oob_tcp_hdr_t;
+
+/* compact header used on connections where both sides
+ * advertised support for it during the connect-ack. Only
+ * a single routed module is active in any given process,
+ * so the routed string carries no information across the
+ * wire and is dropped - this saves 32 bytes per message */
+typedef struct {
+    prte_process_name_t     origin;
+    prte_process_name_t     dst;
+    prte_rml_tag_t tag;
+    uint32_t seq_num;
+    uint32_t nbytes;
+    prte_oob_tcp_msg_type_t type;
+} prte_oob_tcp_chdr_t;
+
+/* flags exchanged in the connect-ack payload */
+#define MCA_OOB_TCP_FLAG_COMPACT_HDR  0x01
+
 /**
  * Convert the message header to host byte order
  */
@@ -85,4 +103,31 @@ typedef struct {
     (h)->tag = PRTE_RML_TAG_HTON((h)->tag);     \
     (h)->nbytes = htonl((h)->nbytes);
 
+/**
+ * Transfer the fields of a full header to a compact one,
+ * or back again. Byte order is left unchanged. The target is
+ * cleared first so no uninitialized padding goes on the wire
+ */
+#define MCA_OOB_TCP_HDR_COMPACT(c, h)           \
+    do {                                        \
+        memset((c), 0, sizeof(prte_oob_tcp_chdr_t)); \
+        (c)->origin = (h)->origin;              \
+        (c)->dst = (h)->dst;                    \
+        (c)->tag = (h)->tag;                    \
+        (c)->seq_num = (h)->seq_num;            \
+        (c)->nbytes = (h)->nbytes;              \
+        (c)->type = (h)->type;                  \
+    } while(0)
+
+#define MCA_OOB_TCP_HDR_EXPAND(h, c)            \
+    do {                                        \
+        memset((h), 0, sizeof(prte_oob_tcp_hdr_t)); \
+        (h)->origin = (c)->origin;              \
+        (h)->dst = (c)->dst;                    \
+        (h)->tag = (c)->tag;                    \
+        (h)->seq_num = (c)->seq_num;            \
+        (h)->nbytes = (c)->nbytes;              \
+        (h)->type = (c)->type;                  \
+    } while(0)
+
 #endif /* _MCA_OOB_TCP_HDR_H_ */
@@ -57,12 +57,19 @@ typedef struct {
     prte_oob_tcp_addr_t *active_addr;
     prte_oob_tcp_state_t state;
     int num_retries;
+    prte_event_base_t *ev_base; /**< event base for this peer's socket events */
+    bool compact_hdr;           /**< both sides agreed to use the compact header */
     prte_event_t send_event;    /**< registration with event thread for send events */
     bool send_ev_active;
     prte_event_t recv_event;    /**< registration with event thread for recv events */
     bool recv_ev_active;
     prte_event_t timer_event;   /**< timer for retrying connection failures */
     bool timer_ev_active;
+    prte_event_t batch_event;   /**< timer for holding sends to be coalesced */
+    bool batch_ev_active;
+    char *rbuf;                 /**< read-ahead buffer for reading multiple msgs at a time */
+    size_t rbuf_start;          /**< offset of the first unparsed byte in rbuf */
+    size_t rbuf_end;            /**< offset of the end of valid data in rbuf */
     prte_list_t send_queue;      /**< list of messages to send */
     prte_oob_tcp_send_t *send_msg; /**< current send in progress */
     prte_oob_tcp_recv_t *recv_msg; /**< current recv in progress */
@@ -90,4 +97,38 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_peer_op_t);
                          (cbfunc), PRTE_MSG_PRI);                       \
     } while(0);
 
+/* the addresses of a peer are only touched by the thread
+ * progressing that peer, so new ones are handed over to it */
+typedef struct {
+    prte_object_t super;
+    prte_event_t ev;
+    prte_oob_tcp_peer_t *peer;
+    prte_oob_tcp_addr_t *addr;
+} prte_oob_tcp_addr_op_t;
+PRTE_CLASS_DECLARATION(prte_oob_tcp_addr_op_t);
+
+#define PRTE_ACTIVATE_TCP_ADDR_OP(p, a, cbfunc)                         \
+    do {                                                                \
+        prte_oob_tcp_addr_op_t *aop;                                    \
+        aop = PRTE_NEW(prte_oob_tcp_addr_op_t);                          \
+        PRTE_RETAIN((p));                                               \
+        aop->peer = (p);                                                \
+        aop->addr = (a);                                                \
+        PRTE_THREADSHIFT(aop, (p)->ev_base,                             \
+                         (cbfunc), PRTE_MSG_PRI);                       \
+    } while(0);
+
+/* assign the peer to one of the OOB progress threads - peers
+ * are sharded by vpid so that all the socket events for a given
+ * peer are always progressed by the same thread */
+#define PRTE_OOB_TCP_PEER_SET_BASE(p)                                   \
+    do {                                                                \
+        if (0 < prte_oob_tcp_component.num_threads) {                   \
+            (p)->ev_base = prte_oob_tcp_component.ev_bases[(p)->name.vpid % \
+                                      prte_oob_tcp_component.num_threads]; \
+        } else {                                                        \
+            (p)->ev_base = prte_event_base;                             \
+        }                                                               \
+    } while(0);
+
 #endif /* _MCA_OOB_TCP_PEER_H_ */
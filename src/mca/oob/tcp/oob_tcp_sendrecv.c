@@ -34,6 +34,7 @@
 #include <unistd.h>
 #endif
 #include <fcntl.h>
+#include <limits.h>
 #ifdef HAVE_SYS_UIO_H
 #include <sys/uio.h>
 #endif
@@ -80,6 +81,30 @@
 
 #define OOB_SEND_MAX_RETRIES 3
 
+/* max number of iovecs we will coalesce into a single writev - the
+ * iovec array lives on the stack, so keep it small. Each msg takes two
+ * entries, and a batch is bounded by batch_max_bytes anyway */
+#if defined(IOV_MAX) && IOV_MAX < 64
+#define OOB_SEND_BATCH_IOV  IOV_MAX
+#else
+#define OOB_SEND_BATCH_IOV  64
+#endif
+
+static void batch_flush(int sd, short flags, void *cbdata)
+{
+    prte_oob_tcp_peer_t *peer = (prte_oob_tcp_peer_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(peer);
+    peer->batch_ev_active = false;
+    /* let the send event pick up everything that accumulated */
+    if (MCA_OOB_TCP_CONNECTED == peer->state &&
+        NULL != peer->send_msg && !peer->send_ev_active) {
+        peer->send_ev_active = true;
+        PRTE_POST_OBJECT(peer);
+        prte_event_add(&peer->send_event, 0);
+    }
+}
+
 void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
 {
     prte_oob_tcp_send_t *snd = (prte_oob_tcp_send_t*)cbdata;
@@ -96,39 +121,116 @@ void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
         prte_list_append(&peer->send_queue, &snd->super);
     }
     if (snd->activate) {
-        /* if we aren't connected, then start connecting */
-        if (MCA_OOB_TCP_CONNECTED != peer->state) {
+        if (MCA_OOB_TCP_CONNECTING == peer->state ||
+            MCA_OOB_TCP_CONNECT_ACK == peer->state) {
+            /* the message goes out once the connection completes */
+            prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                                "%s tcp:queue_msg: connection to %s in progress - holding send",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                PRTE_NAME_PRINT(&peer->name));
+        } else if (MCA_OOB_TCP_CONNECTED != peer->state) {
+            /* if we aren't connected, then start connecting */
+            prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                                "%s tcp:queue_msg: initiating connection to %s",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                PRTE_NAME_PRINT(&peer->name));
             peer->state = MCA_OOB_TCP_CONNECTING;
             PRTE_ACTIVATE_TCP_CONN_STATE(peer, prte_oob_tcp_peer_try_connect);
         } else {
             /* ensure the send event is active */
             if (!peer->send_ev_active) {
-                peer->send_ev_active = true;
-                PRTE_POST_OBJECT(peer);
-                prte_event_add(&peer->send_event, 0);
+                if (prte_oob_tcp_component.batch_sends &&
+                    0 < prte_oob_tcp_component.batch_delay) {
+                    /* hold the send briefly so that any messages
+                     * that follow can be coalesced with this one */
+                    if (!peer->batch_ev_active) {
+                        struct timeval tv;
+                        tv.tv_sec = prte_oob_tcp_component.batch_delay / 1000000;
+                        tv.tv_usec = prte_oob_tcp_component.batch_delay % 1000000;
+                        peer->batch_ev_active = true;
+                        prte_event_evtimer_set(peer->ev_base, &peer->batch_event,
+                                               batch_flush, peer);
+                        PRTE_POST_OBJECT(peer);
+                        prte_event_evtimer_add(&peer->batch_event, &tv);
+                    }
+                } else {
+                    peer->send_ev_active = true;
+                    PRTE_POST_OBJECT(peer);
+                    prte_event_add(&peer->send_event, 0);
+                }
             }
         }
     }
 }
 
+/* if the header of this message hasn't started onto the
+ * wire yet, point the send at the header format negotiated
+ * with this peer */
+static void set_hdr_format(prte_oob_tcp_peer_t* peer, prte_oob_tcp_send_t* msg)
+{
+    if (msg->hdr_sent) {
+        return;
+    }
+    if (msg->sdptr == (char*)&msg->hdr && msg->sdbytes == sizeof(prte_oob_tcp_hdr_t)) {
+        if (!peer->compact_hdr) {
+            return;
+        }
+        msg->compact = true;
+        MCA_OOB_TCP_HDR_COMPACT(&msg->chdr, &msg->hdr);
+        msg->sdptr = (char*)&msg->chdr;
+        msg->sdbytes = sizeof(prte_oob_tcp_chdr_t);
+    } else if (msg->sdptr == (char*)&msg->chdr && msg->sdbytes == sizeof(prte_oob_tcp_chdr_t)) {
+        /* may have been requeued to a different peer */
+        if (peer->compact_hdr) {
+            return;
+        }
+        msg->compact = false;
+        msg->sdptr = (char*)&msg->hdr;
+        msg->sdbytes = sizeof(prte_oob_tcp_hdr_t);
+    }
+    /* otherwise part of the header is already on the wire */
+}
+
+/* track the header overhead once the header is on the wire */
+static void account_hdr(prte_oob_tcp_send_t* msg)
+{
+    if (msg->compact) {
+        PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.hdr_bytes,
+                                     sizeof(prte_oob_tcp_chdr_t));
+        PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.hdr_bytes_saved,
+                                     sizeof(prte_oob_tcp_hdr_t) - sizeof(prte_oob_tcp_chdr_t));
+    } else {
+        PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.hdr_bytes,
+                                     sizeof(prte_oob_tcp_hdr_t));
+    }
+}
+
+/* get the payload to be sent after the header */
+static char* msg_body(prte_oob_tcp_send_t* msg)
+{
+    if (NULL != msg->data) {
+        /* relay message - just send that data */
+        return msg->data;
+    } else if (NULL != msg->msg->buffer) {
+        /* buffer send */
+        return msg->msg->buffer->base_ptr;
+    }
+    return msg->msg->data;
+}
+
 static int send_msg(prte_oob_tcp_peer_t* peer, prte_oob_tcp_send_t* msg)
 {
     struct iovec iov[2];
     int iov_count, retries = 0;
-    ssize_t remain = msg->sdbytes, rc;
+    ssize_t remain, rc;
+
+    set_hdr_format(peer, msg);
+    remain = msg->sdbytes;
 
     iov[0].iov_base = msg->sdptr;
     iov[0].iov_len = msg->sdbytes;
     if (!msg->hdr_sent) {
-        if (NULL != msg->data) {
-            /* relay message - just send that data */
-            iov[1].iov_base = msg->data;
-        } else if (NULL != msg->msg->buffer) {
-            /* buffer send */
-            iov[1].iov_base = msg->msg->buffer->base_ptr;
-        } else {
-            iov[1].iov_base = msg->msg->data;
-        }
+        iov[1].iov_base = msg_body(msg);
         iov[1].iov_len = ntohl(msg->hdr.nbytes);
         remain += ntohl(msg->hdr.nbytes);
         iov_count = 2;
@@ -137,9 +239,13 @@ static int send_msg(prte_oob_tcp_peer_t* peer, prte_oob_tcp_send_t* msg)
     }
 
   retry:
+    PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.num_writes, 1);
     rc = writev(peer->sd, iov, iov_count);
     if (PRTE_LIKELY(rc == remain)) {
         /* we successfully sent the header and the msg data if any */
+        if (!msg->hdr_sent) {
+            account_hdr(msg);
+        }
         msg->hdr_sent = true;
         msg->sdbytes = 0;
         msg->sdptr = (char *)iov[iov_count-1].iov_base + iov[iov_count-1].iov_len;
@@ -184,6 +290,7 @@ static int send_msg(prte_oob_tcp_peer_t* peer, prte_oob_tcp_send_t* msg)
             msg->sdbytes -= rc;
         } else {
             /* header was fully written, but only a part of the msg data was written */
+            account_hdr(msg);
             msg->hdr_sent = true;
             rc -= msg->sdbytes;
             assert(2 == iov_count);
@@ -194,6 +301,186 @@ static int send_msg(prte_oob_tcp_peer_t* peer, prte_oob_tcp_send_t* msg)
     }
 }
 
+static void send_cbfunc(int sd, short args, void *cbdata)
+{
+    prte_oob_tcp_msg_op_t *mop = (prte_oob_tcp_msg_op_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(mop);
+    PRTE_RML_SEND_COMPLETE(mop->msg);
+    PRTE_RELEASE(mop);
+}
+
+/* complete the RML send - its callbacks must run in the
+ * framework event base, so shift them there if we are
+ * running in one of our own progress threads */
+static void notify_rml(prte_rml_send_t *msg)
+{
+    prte_oob_tcp_msg_op_t *mop;
+
+    if (0 == prte_oob_tcp_component.num_threads) {
+        PRTE_RML_SEND_COMPLETE(msg);
+        return;
+    }
+    mop = PRTE_NEW(prte_oob_tcp_msg_op_t);
+    mop->msg = msg;
+    PRTE_THREADSHIFT(mop, prte_event_base, send_cbfunc, PRTE_MSG_PRI);
+}
+
+/* the given message has been fully written - release
+ * it and notify the RML if we originated it */
+static void send_complete(prte_oob_tcp_peer_t* peer, prte_oob_tcp_send_t* msg)
+{
+    PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.msgs_sent, 1);
+    if (NULL != msg->data || NULL == msg->msg) {
+        /* the relay is complete - release the data */
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        PRTE_RELEASE(msg);
+    } else if (NULL != msg->msg->buffer) {
+        /* we are done - notify the RML */
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                            "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        msg->msg->status = PRTE_SUCCESS;
+        notify_rml(msg->msg);
+        PRTE_RELEASE(msg);
+    } else {
+        /* this was a relay we have now completed - no need to
+         * notify the RML as the local proc didn't initiate
+         * the send
+         */
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        msg->msg->status = PRTE_SUCCESS;
+        PRTE_RELEASE(msg);
+    }
+}
+
+/* coalesce the on-deck message and as many of the queued messages
+ * as allowed into a single writev. Completed messages are released
+ * and the first incomplete one is left on-deck */
+static int send_batch(prte_oob_tcp_peer_t* peer)
+{
+    struct iovec iov[OOB_SEND_BATCH_IOV];
+    prte_oob_tcp_send_t *batch[OOB_SEND_BATCH_IOV / 2];
+    prte_oob_tcp_send_t *snd;
+    int i, nmsgs = 0, niov = 0, retries = 0;
+    size_t bytes = 0, len;
+    ssize_t rc;
+
+    /* gather the messages */
+    snd = peer->send_msg;
+    while (NULL != snd) {
+        /* multi-iovec sends are only progressed one at a time */
+        if (NULL == snd->data && NULL != snd->msg && NULL != snd->msg->iov) {
+            break;
+        }
+        if (OOB_SEND_BATCH_IOV < niov + 2 ||
+            (0 < nmsgs && (size_t)prte_oob_tcp_component.batch_max_bytes <= bytes)) {
+            break;
+        }
+        set_hdr_format(peer, snd);
+        iov[niov].iov_base = snd->sdptr;
+        iov[niov].iov_len = snd->sdbytes;
+        bytes += snd->sdbytes;
+        ++niov;
+        if (!snd->hdr_sent) {
+            iov[niov].iov_base = msg_body(snd);
+            iov[niov].iov_len = ntohl(snd->hdr.nbytes);
+            bytes += iov[niov].iov_len;
+            ++niov;
+        }
+        batch[nmsgs++] = snd;
+        if (snd == peer->send_msg) {
+            snd = (prte_oob_tcp_send_t*)prte_list_get_first(&peer->send_queue);
+        } else {
+            snd = (prte_oob_tcp_send_t*)prte_list_get_next(&snd->super);
+        }
+        if ((prte_list_item_t*)snd == prte_list_get_end(&peer->send_queue)) {
+            snd = NULL;
+        }
+    }
+
+  retry:
+    PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.num_writes, 1);
+    rc = writev(peer->sd, iov, niov);
+    if (rc < 0) {
+        if (prte_socket_errno == EINTR) {
+            goto retry;
+        } else if (prte_socket_errno == EAGAIN ||
+                   prte_socket_errno == EWOULDBLOCK) {
+            ++retries;
+            if (retries < OOB_SEND_MAX_RETRIES) {
+                goto retry;
+            }
+            return PRTE_ERR_RESOURCE_BUSY;
+        }
+        /* we hit an error and cannot progress these messages */
+        prte_output(0, "oob:tcp: send_batch: writev failed: %s (%d) [sd = %d]",
+                    strerror(prte_socket_errno),
+                    prte_socket_errno, peer->sd);
+        return PRTE_ERR_UNREACH;
+    }
+
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                        "%s tcp:send_batch wrote %d of %d bytes from %d msgs to %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int)rc, (int)bytes,
+                        nmsgs, PRTE_NAME_PRINT(&peer->name));
+
+    /* account for what was written */
+    for (i=0; i < nmsgs; i++) {
+        snd = batch[i];
+        len = snd->sdbytes;
+        if (!snd->hdr_sent) {
+            len += ntohl(snd->hdr.nbytes);
+        }
+        if ((size_t)rc < len) {
+            /* partial write - update this msg and stop */
+            if ((size_t)rc < snd->sdbytes) {
+                snd->sdptr = (char *)snd->sdptr + rc;
+                snd->sdbytes -= rc;
+            } else {
+                /* header was fully written, but only a part of the msg data was written */
+                account_hdr(snd);
+                snd->hdr_sent = true;
+                rc -= snd->sdbytes;
+                snd->sdptr = msg_body(snd) + rc;
+                snd->sdbytes = ntohl(snd->hdr.nbytes) - rc;
+            }
+            break;
+        }
+        rc -= len;
+        if (!snd->hdr_sent) {
+            account_hdr(snd);
+        }
+        if (snd == peer->send_msg) {
+            peer->send_msg = NULL;
+        } else {
+            prte_list_remove_item(&peer->send_queue, &snd->super);
+        }
+        send_complete(peer, snd);
+    }
+
+    /* the first incomplete msg, if any, is now at the
+     * front of the queue - put it on-deck */
+    if (NULL == peer->send_msg) {
+        peer->send_msg = (prte_oob_tcp_send_t*)
+            prte_list_remove_first(&peer->send_queue);
+    }
+    if (i < nmsgs) {
+        return PRTE_ERR_RESOURCE_BUSY;
+    }
+    return PRTE_SUCCESS;
+}
+
 /*
  * A file descriptor is available/ready for send. Check the state
  * of the socket and take the appropriate action.
@@ -233,43 +520,41 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                             "%s tcp:send_handler SENDING TO %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             (NULL == peer->send_msg) ? "NULL" : PRTE_NAME_PRINT(&peer->name));
-        if (NULL != msg) {
+        if (NULL != msg && prte_oob_tcp_component.batch_sends &&
+            !prte_list_is_empty(&peer->send_queue) &&
+            (NULL != msg->data || NULL == msg->msg || NULL == msg->msg->iov)) {
+            prte_output_verbose(2, prte_oob_base_framework.framework_output,
+                                "oob:tcp:send_handler SENDING BATCH");
+            rc = send_batch(peer);
+            if (PRTE_ERR_RESOURCE_BUSY == rc) {
+                /* exit this event and let the event lib progress */
+                return;
+            } else if (PRTE_SUCCESS != rc) {
+                // report the error
+                prte_output(0, "%s-%s prte_oob_tcp_peer_send_handler: unable to send message ON SOCKET %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&(peer->name)), peer->sd);
+                prte_event_del(&peer->send_event);
+                msg = peer->send_msg;
+                if (NULL != msg->msg) {
+                    msg->msg->status = rc;
+                    notify_rml(msg->msg);
+                }
+                PRTE_RELEASE(msg);
+                peer->send_msg = NULL;
+                PRTE_FORCED_TERMINATE(1);
+                return;
+            }
+            /* fall thru so the send event is dropped if we are done -
+             * otherwise, we cycle back to send the next batch */
+        } else if (NULL != msg) {
             prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                 "oob:tcp:send_handler SENDING MSG");
             if (PRTE_SUCCESS == (rc = send_msg(peer, msg))) {
                 /* this msg is complete */
-                if (NULL != msg->data || NULL == msg->msg) {
-                    /* the relay is complete - release the data */
-                    prte_output_verbose(2, prte_oob_base_framework.framework_output,
-                                        "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&(peer->name)),
-                                        (int)ntohl(msg->hdr.nbytes), peer->sd);
-                    PRTE_RELEASE(msg);
-                    peer->send_msg = NULL;
-                } else if (NULL != msg->msg->buffer) {
-                    /* we are done - notify the RML */
-                    prte_output_verbose(2, prte_oob_base_framework.framework_output,
-                                        "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&(peer->name)),
-                                        (int)ntohl(msg->hdr.nbytes), peer->sd);
-                    msg->msg->status = PRTE_SUCCESS;
-                    PRTE_RML_SEND_COMPLETE(msg->msg);
-                    PRTE_RELEASE(msg);
-                    peer->send_msg = NULL;
-                } else if (NULL != msg->msg->data) {
-                    /* this was a relay we have now completed - no need to
-                     * notify the RML as the local proc didn't initiate
-                     * the send
-                     */
-                    prte_output_verbose(2, prte_oob_base_framework.framework_output,
-                                        "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&(peer->name)),
-                                        (int)ntohl(msg->hdr.nbytes), peer->sd);
-                    msg->msg->status = PRTE_SUCCESS;
-                    PRTE_RELEASE(msg);
+                if (NULL != msg->data || NULL == msg->msg ||
+                    NULL != msg->msg->buffer || NULL != msg->msg->data) {
+                    send_complete(peer, msg);
                     peer->send_msg = NULL;
                 } else {
                     /* rotate to the next iovec */
@@ -290,7 +575,7 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                                             PRTE_NAME_PRINT(&(peer->name)),
                                             (int)ntohl(msg->hdr.nbytes), peer->sd);
                         msg->msg->status = PRTE_SUCCESS;
-                        PRTE_RML_SEND_COMPLETE(msg->msg);
+                        notify_rml(msg->msg);
                         PRTE_RELEASE(msg);
                         peer->send_msg = NULL;
                     }
@@ -307,7 +592,7 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                             PRTE_NAME_PRINT(&(peer->name)), peer->sd);
                 prte_event_del(&peer->send_event);
                 msg->msg->status = rc;
-                PRTE_RML_SEND_COMPLETE(msg->msg);
+                notify_rml(msg->msg);
                 PRTE_RELEASE(msg);
                 peer->send_msg = NULL;
                 PRTE_FORCED_TERMINATE(1);
@@ -343,13 +628,15 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
     }
 }
 
-static int read_bytes(prte_oob_tcp_peer_t* peer)
+/* read whatever is available on the socket, up to len bytes */
+static int read_chunk(prte_oob_tcp_peer_t* peer, char *ptr, size_t len, size_t *nread)
 {
-    int rc;
+    ssize_t rc;
 
-    /* read until all bytes recvd or error */
-    while (0 < peer->recv_msg->rdbytes) {
-        rc = read(peer->sd, peer->recv_msg->rdptr, peer->recv_msg->rdbytes);
+    *nread = 0;
+    while (1) {
+        PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.num_reads, 1);
+        rc = read(peer->sd, ptr, len);
         if (rc < 0) {
             if(prte_socket_errno == EINTR) {
                 continue;
@@ -412,15 +699,204 @@ static int read_bytes(prte_oob_tcp_peer_t* peer)
             //}
             return PRTE_ERR_WOULD_BLOCK;
         }
-        /* we were able to read something, so adjust counters and location */
-        peer->recv_msg->rdbytes -= rc;
-        peer->recv_msg->rdptr += rc;
+        /* we were able to read something */
+        *nread = rc;
+        return PRTE_SUCCESS;
+    }
+}
+
+static int read_bytes(prte_oob_tcp_peer_t* peer)
+{
+    size_t nread;
+    int rc;
+
+    /* read until all bytes recvd or error */
+    while (0 < peer->recv_msg->rdbytes) {
+        if (PRTE_SUCCESS != (rc = read_chunk(peer, peer->recv_msg->rdptr,
+                                             peer->recv_msg->rdbytes, &nread))) {
+            return rc;
+        }
+        /* adjust counters and location */
+        peer->recv_msg->rdbytes -= nread;
+        peer->recv_msg->rdptr += nread;
     }
 
     /* we read the full data block */
     return PRTE_SUCCESS;
 }
 
+/* a complete message has been read into peer->recv_msg - deliver it
+ * to the RML if it is for us, or relay it towards its destination */
+static void msg_recvd(prte_oob_tcp_peer_t* peer)
+{
+    prte_rml_send_t *snd;
+
+    PRTE_ATOMIC_ADD_FETCH_SIZE_T(&prte_oob_tcp_component.msgs_recvd, 1);
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                        "%s RECVD COMPLETE MESSAGE FROM %s (ORIGIN %s) OF %d BYTES FOR DEST %s TAG %d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        PRTE_NAME_PRINT(&peer->name),
+                        PRTE_NAME_PRINT(&peer->recv_msg->hdr.origin),
+                        (int)peer->recv_msg->hdr.nbytes,
+                        PRTE_NAME_PRINT(&peer->recv_msg->hdr.dst),
+                        peer->recv_msg->hdr.tag);
+
+    /* am I the intended recipient (header was already converted back to host order)? */
+    if (peer->recv_msg->hdr.dst.jobid == PRTE_PROC_MY_NAME->jobid &&
+        peer->recv_msg->hdr.dst.vpid == PRTE_PROC_MY_NAME->vpid) {
+        /* yes - post it to the RML for delivery */
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                            "%s DELIVERING TO RML tag = %d seq_num = %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            peer->recv_msg->hdr.tag,
+                            peer->recv_msg->hdr.seq_num);
+        PRTE_RML_POST_MESSAGE(&peer->recv_msg->hdr.origin,
+                              peer->recv_msg->hdr.tag,
+                              peer->recv_msg->hdr.seq_num,
+                              peer->recv_msg->data,
+                              peer->recv_msg->hdr.nbytes);
+        PRTE_RELEASE(peer->recv_msg);
+    } else {
+        /* promote this to the OOB as some other transport might
+         * be the next best hop */
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                            "%s TCP PROMOTING ROUTED MESSAGE FOR %s TO OOB",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&peer->recv_msg->hdr.dst));
+        snd = PRTE_NEW(prte_rml_send_t);
+        snd->dst = peer->recv_msg->hdr.dst;
+        snd->origin = peer->recv_msg->hdr.origin;
+        snd->tag = peer->recv_msg->hdr.tag;
+        snd->data = peer->recv_msg->data;
+        snd->seq_num = peer->recv_msg->hdr.seq_num;
+        snd->count = peer->recv_msg->hdr.nbytes;
+        snd->cbfunc.iov = NULL;
+        snd->cbdata = NULL;
+        /* activate the OOB send state */
+        PRTE_OOB_SEND(snd);
+        /* protect the data */
+        peer->recv_msg->data = NULL;
+        /* cleanup */
+        PRTE_RELEASE(peer->recv_msg);
+    }
+    peer->recv_msg = NULL;
+}
+
+/* extract the header of the frame at the given location in
+ * the peer's read-ahead buffer, converted to host byte order */
+static void peek_hdr(prte_oob_tcp_peer_t* peer, char *ptr, prte_oob_tcp_hdr_t *hdr)
+{
+    prte_oob_tcp_chdr_t chdr;
+
+    if (peer->compact_hdr) {
+        memcpy(&chdr, ptr, sizeof(prte_oob_tcp_chdr_t));
+        MCA_OOB_TCP_HDR_EXPAND(hdr, &chdr);
+    } else {
+        memcpy(hdr, ptr, sizeof(prte_oob_tcp_hdr_t));
+    }
+    MCA_OOB_TCP_HDR_NTOH(hdr);
+}
+
+/* copy all complete messages out of the peer's read-ahead buffer.
+ * A partial message that will fit in the buffer is left there to
+ * be completed by the next read. A message too large for the
+ * buffer is moved to peer->recv_msg so the remainder of its body
+ * can be read directly into place */
+static void parse_frames(prte_oob_tcp_peer_t* peer)
+{
+    prte_oob_tcp_recv_t *recv;
+    prte_oob_tcp_hdr_t hdr;
+    size_t hdrsize, avail;
+
+    hdrsize = peer->compact_hdr ? sizeof(prte_oob_tcp_chdr_t) : sizeof(prte_oob_tcp_hdr_t);
+
+    while (hdrsize <= (avail = peer->rbuf_end - peer->rbuf_start)) {
+        peek_hdr(peer, peer->rbuf + peer->rbuf_start, &hdr);
+        if (avail < hdrsize + hdr.nbytes &&
+            hdrsize + hdr.nbytes <= (size_t)prte_oob_tcp_component.read_ahead_size) {
+            /* wait for the rest of it to arrive */
+            return;
+        }
+        recv = PRTE_NEW(prte_oob_tcp_recv_t);
+        recv->hdr = hdr;
+        recv->hdr_recvd = true;
+        peer->rbuf_start += hdrsize;
+        avail -= hdrsize;
+        peer->recv_msg = recv;
+
+        if (0 < hdr.nbytes) {
+            recv->data = (char*)malloc(hdr.nbytes);
+            if (avail < hdr.nbytes) {
+                /* only part of the body is here - the rest will
+                 * be read directly into place */
+                memcpy(recv->data, peer->rbuf + peer->rbuf_start, avail);
+                peer->rbuf_start += avail;
+                recv->rdptr = recv->data + avail;
+                recv->rdbytes = hdr.nbytes - avail;
+                return;
+            }
+            memcpy(recv->data, peer->rbuf + peer->rbuf_start, hdr.nbytes);
+            peer->rbuf_start += hdr.nbytes;
+        }
+        msg_recvd(peer);
+    }
+}
+
+/* read as much as is available into the peer's read-ahead buffer
+ * and process every complete message found there. The buffer is
+ * linear - leftover data is moved to the front when needed */
+static int recv_buffered(prte_oob_tcp_peer_t* peer)
+{
+    prte_oob_tcp_hdr_t hdr;
+    size_t nread, space, hdrsize, need;
+    int rc;
+
+    /* finish any body that is being read directly into place */
+    if (NULL != peer->recv_msg) {
+        if (PRTE_SUCCESS != (rc = read_bytes(peer))) {
+            return rc;
+        }
+        msg_recvd(peer);
+    }
+
+    if (NULL == peer->rbuf) {
+        peer->rbuf = (char*)malloc(prte_oob_tcp_component.read_ahead_size);
+        if (NULL == peer->rbuf) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        peer->rbuf_start = 0;
+        peer->rbuf_end = 0;
+    }
+
+    if (peer->rbuf_start == peer->rbuf_end) {
+        /* nothing pending - rewind for free */
+        peer->rbuf_start = 0;
+        peer->rbuf_end = 0;
+    } else {
+        /* only shift the pending partial msg to the front
+         * if it cannot be completed where it sits */
+        hdrsize = peer->compact_hdr ? sizeof(prte_oob_tcp_chdr_t) : sizeof(prte_oob_tcp_hdr_t);
+        need = hdrsize;
+        if (hdrsize <= peer->rbuf_end - peer->rbuf_start) {
+            peek_hdr(peer, peer->rbuf + peer->rbuf_start, &hdr);
+            need += hdr.nbytes;
+        }
+        if ((size_t)prte_oob_tcp_component.read_ahead_size - peer->rbuf_start < need) {
+            memmove(peer->rbuf, peer->rbuf + peer->rbuf_start,
+                    peer->rbuf_end - peer->rbuf_start);
+            peer->rbuf_end -= peer->rbuf_start;
+            peer->rbuf_start = 0;
+        }
+    }
+    space = prte_oob_tcp_component.read_ahead_size - peer->rbuf_end;
+    if (PRTE_SUCCESS != (rc = read_chunk(peer, peer->rbuf + peer->rbuf_end, space, &nread))) {
+        return rc;
+    }
+    peer->rbuf_end += nread;
+    parse_frames(peer);
+    return PRTE_SUCCESS;
+}
+
 /*
  * Dispatch to the appropriate action routine based on the state
  * of the connection with the peer.
@@ -430,7 +906,6 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
 {
     prte_oob_tcp_peer_t* peer = (prte_oob_tcp_peer_t*)cbdata;
     int rc;
-    prte_rml_send_t *snd;
 
     PRTE_ACQUIRE_OBJECT(peer);
 
@@ -483,6 +958,24 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
         prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s:tcp:recv:handler CONNECTED",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        if (0 < prte_oob_tcp_component.read_ahead_size) {
+            /* read as many msgs as we can at a time */
+            rc = recv_buffered(peer);
+            if (PRTE_SUCCESS == rc ||
+                PRTE_ERR_RESOURCE_BUSY == rc ||
+                PRTE_ERR_WOULD_BLOCK == rc) {
+                /* exit this event and let the event lib progress */
+                return;
+            }
+            // report the error
+            prte_output(0, "%s-%s prte_oob_tcp_peer_recv_handler: unable to recv message",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        PRTE_NAME_PRINT(&(peer->name)));
+            /* turn off the recv event */
+            prte_event_del(&peer->recv_event);
+            PRTE_FORCED_TERMINATE(1);
+            return;
+        }
         /* allocate a new message and setup for recv */
         if (NULL == peer->recv_msg) {
             prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
@@ -495,9 +988,14 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                             PRTE_NAME_PRINT(&(peer->name)));
                 return;
             }
-            /* start by reading the header */
-            peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
-            peer->recv_msg->rdbytes = sizeof(prte_oob_tcp_hdr_t);
+            /* start by reading the header in the negotiated format */
+            if (peer->compact_hdr) {
+                peer->recv_msg->rdptr = (char*)&peer->recv_msg->chdr;
+                peer->recv_msg->rdbytes = sizeof(prte_oob_tcp_chdr_t);
+            } else {
+                peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
+                peer->recv_msg->rdbytes = sizeof(prte_oob_tcp_hdr_t);
+            }
         }
         /* if the header hasn't been completely read, read it */
         if (!peer->recv_msg->hdr_recvd) {
@@ -507,6 +1005,9 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
             if (PRTE_SUCCESS == (rc = read_bytes(peer))) {
                 /* completed reading the header */
                 peer->recv_msg->hdr_recvd = true;
+                if (peer->compact_hdr) {
+                    MCA_OOB_TCP_HDR_EXPAND(&peer->recv_msg->hdr, &peer->recv_msg->chdr);
+                }
                 /* convert the header */
                 MCA_OOB_TCP_HDR_NTOH(&peer->recv_msg->hdr);
                 /* if this is a zero-byte message, then we are done */
@@ -548,54 +1049,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
              */
             if (PRTE_SUCCESS == (rc = read_bytes(peer))) {
                 /* we recvd all of the message */
-                prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
-                                    "%s RECVD COMPLETE MESSAGE FROM %s (ORIGIN %s) OF %d BYTES FOR DEST %s TAG %d",
-                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                    PRTE_NAME_PRINT(&peer->name),
-                                    PRTE_NAME_PRINT(&peer->recv_msg->hdr.origin),
-                                    (int)peer->recv_msg->hdr.nbytes,
-                                    PRTE_NAME_PRINT(&peer->recv_msg->hdr.dst),
-                                    peer->recv_msg->hdr.tag);
-
-                /* am I the intended recipient (header was already converted back to host order)? */
-                if (peer->recv_msg->hdr.dst.jobid == PRTE_PROC_MY_NAME->jobid &&
-                    peer->recv_msg->hdr.dst.vpid == PRTE_PROC_MY_NAME->vpid) {
-                    /* yes - post it to the RML for delivery */
-                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
-                                        "%s DELIVERING TO RML tag = %d seq_num = %d",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        peer->recv_msg->hdr.tag,
-                                        peer->recv_msg->hdr.seq_num);
-                    PRTE_RML_POST_MESSAGE(&peer->recv_msg->hdr.origin,
-                                          peer->recv_msg->hdr.tag,
-                                          peer->recv_msg->hdr.seq_num,
-                                          peer->recv_msg->data,
-                                          peer->recv_msg->hdr.nbytes);
-                    PRTE_RELEASE(peer->recv_msg);
-                } else {
-                    /* promote this to the OOB as some other transport might
-                     * be the next best hop */
-                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
-                                        "%s TCP PROMOTING ROUTED MESSAGE FOR %s TO OOB",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&peer->recv_msg->hdr.dst));
-                    snd = PRTE_NEW(prte_rml_send_t);
-                    snd->dst = peer->recv_msg->hdr.dst;
-                    snd->origin = peer->recv_msg->hdr.origin;
-                    snd->tag = peer->recv_msg->hdr.tag;
-                    snd->data = peer->recv_msg->data;
-                    snd->seq_num = peer->recv_msg->hdr.seq_num;
-                    snd->count = peer->recv_msg->hdr.nbytes;
-                    snd->cbfunc.iov = NULL;
-                    snd->cbdata = NULL;
-                    /* activate the OOB send state */
-                    PRTE_OOB_SEND(snd);
-                    /* protect the data */
-                    peer->recv_msg->data = NULL;
-                    /* cleanup */
-                    PRTE_RELEASE(peer->recv_msg);
-                }
-                peer->recv_msg = NULL;
+                msg_recvd(peer);
                 return;
             } else if (PRTE_ERR_RESOURCE_BUSY == rc ||
                        PRTE_ERR_WOULD_BLOCK == rc) {
@@ -626,6 +1080,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
 static void snd_cons(prte_oob_tcp_send_t *ptr)
 {
     memset(&ptr->hdr, 0, sizeof(prte_oob_tcp_hdr_t));
+    ptr->compact = false;
     ptr->msg = NULL;
     ptr->data = NULL;
     ptr->hdr_sent = false;
@@ -45,6 +45,8 @@ typedef struct {
     struct prte_oob_tcp_peer_t *peer;
     bool activate;
     prte_oob_tcp_hdr_t hdr;
+    prte_oob_tcp_chdr_t chdr;   // wire form of hdr on compact connections
+    bool compact;               // chdr is the form being sent
     prte_rml_send_t *msg;
     char *data;
     bool hdr_sent;
@@ -58,6 +60,7 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_send_t);
 typedef struct {
     prte_list_item_t super;
     prte_oob_tcp_hdr_t hdr;
+    prte_oob_tcp_chdr_t chdr;   // wire form of hdr on compact connections
     bool hdr_recvd;
     char *data;
     char *rdptr;
@@ -85,7 +88,7 @@ PRTE_CLASS_DECLARATION(prte_oob_tcp_recv_t);
     do {                                                                \
         (s)->peer = (struct prte_oob_tcp_peer_t*)(p);                    \
         (s)->activate = (f);                                            \
-        PRTE_THREADSHIFT((s), prte_event_base,                             \
+        PRTE_THREADSHIFT((s), (p)->ev_base,                             \
                          prte_oob_tcp_queue_msg, PRTE_MSG_PRI);          \
     } while(0)
 
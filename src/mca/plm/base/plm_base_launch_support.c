@@ -1381,6 +1381,7 @@ void prte_plm_base_daemon_callback(int status, prte_process_name_t* sender,
             alias = prte_argv_join(atmp, ',');
             prte_set_attribute(&daemon->node->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, alias, PRTE_STRING);
             free(alias);
+            prte_node_index_add(daemon->node);
         }
         prte_argv_free(atmp);
 
@@ -2365,6 +2366,7 @@ int prte_plm_base_setup_virtual_machine(prte_job_t *jdata)
         /* point the proc to the node and maintain accounting */
         proc->node = node;
         PRTE_RETAIN(node);
+        prte_util_nidmap_record(node, PRTE_NIDMAP_UPDATE);
         if (prte_plm_globals.daemon_nodes_assigned_at_launch) {
             PRTE_FLAG_SET(node, PRTE_NODE_FLAG_LOC_VERIFIED);
         } else {
@@ -34,6 +34,7 @@
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/rmaps/base/base.h"
 #include "src/util/name_fns.h"
+#include "src/util/nidmap.h"
 #include "src/util/proc_info.h"
 #include "src/runtime/prte_globals.h"
 
@@ -171,6 +172,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                     ptr = prte_argv_join(alias, ',');
                     prte_set_attribute(&hnp_node->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, ptr, PRTE_STRING);
                     free(ptr);
+                    prte_node_index_add(hnp_node);
                 }
                 prte_argv_free(alias);
             }
@@ -181,6 +183,8 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                 prte_dss.copy((void**)&node, hnp_node, PRTE_NODE);
                 PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_DAEMON_LAUNCHED);
                 node->index = prte_pointer_array_add(prte_node_pool, node);
+                prte_node_index_add(node);
+                prte_util_nidmap_record(node, PRTE_NIDMAP_ADD);
             }
         } else {
             /* insert the object onto the prte_nodes global array */
@@ -201,6 +205,8 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
                 PRTE_ERROR_LOG(rc);
                 return rc;
             }
+            prte_node_index_add(node);
+            prte_util_nidmap_record(node, PRTE_NIDMAP_ADD);
             if (prte_do_not_launch) {
                 /* create a daemon for this node since we won't be launching
                  * and the mapper needs to see a daemon - this is used solely
@@ -227,6 +233,8 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
             for (i=1; i < prte_ras_base.multiplier; i++) {
                 prte_dss.copy((void**)&nptr, node, PRTE_NODE);
                 nptr->index = prte_pointer_array_add(prte_node_pool, nptr);
+                prte_node_index_add(nptr);
+                prte_util_nidmap_record(nptr, PRTE_NIDMAP_ADD);
             }
        }
     }
@@ -238,6 +246,7 @@ int prte_ras_base_node_insert(prte_list_t* nodes, prte_job_t *jdata)
     if (NULL != hnp_node && !prte_have_fqdn_allocation && !hnp_alone) {
         if (NULL != (ptr = strchr(hnp_node->name, '.'))) {
             *ptr = '\0';
+            prte_node_index_add(hnp_node);
         }
     }
 
@@ -69,6 +69,8 @@ typedef struct {
     bool inherit;
     /* whether or not we are using hwthreads as independent cpus by default */
     bool hwthread_cpus;
+    /* number of threads to use when computing per-node bindings */
+    int bind_threads;
 } prte_rmaps_base_t;
 
 /**
@@ -37,6 +37,7 @@
 #include "src/mca/mca.h"
 #include "src/mca/base/base.h"
 #include "src/hwloc/hwloc-internal.h"
+#include "src/threads/threads.h"
 #include "src/threads/tsd.h"
 
 #include "types.h"
@@ -69,6 +70,27 @@ static bool membind_warned=false;
  * to recording usage etc in the userdata object */
 
 
+/* Bindings are normally computed by each daemon for its own procs
+ * only, using the policy and per-node proc counts carried in the
+ * launch message - the HNP never ships them. The HNP only needs the
+ * bindings of procs on every node when it has to show them to the
+ * user or the job is not actually being launched. The computation
+ * is deterministic, so the HNP arrives at the same result as the
+ * daemons */
+bool prte_rmaps_base_binding_on_hnp(prte_job_t *jdata)
+{
+    if (!PRTE_PROC_IS_MASTER) {
+        return false;
+    }
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PRTE_BOOL) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PRTE_BOOL) ||
+        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PRTE_BOOL)) {
+        return true;
+    }
+    return false;
+}
+
 static void reset_usage(prte_node_t *node, prte_jobid_t jobid)
 {
     int j;
@@ -100,10 +122,8 @@ static void reset_usage(prte_node_t *node, prte_jobid_t jobid)
                                 PRTE_NAME_PRINT(&proc->name));
             continue;
         }
-        bound = NULL;
         /* get the object to which this proc is bound */
-        if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, (void**)&bound, PRTE_PTR) ||
-            NULL == bound) {
+        if (NULL == (bound = (hwloc_obj_t)prte_get_attribute_ptr(&proc->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_PTR))) {
             /* this proc isn't bound - ignore it */
             prte_output_verbose(10, prte_rmaps_base_framework.framework_output,
                                 "%s reset_usage: proc %s has no bind location",
@@ -140,76 +160,154 @@ static void unbind_procs(prte_job_t *jdata)
     }
 }
 
-static int bind_generic(prte_job_t *jdata,
-                        prte_node_t *node,
-                        int target_depth)
+/* The binding of procs on one node is independent of every other
+ * node, so bind_generic can be run for several nodes at once. Nodes
+ * with identical hardware share a single topology object, though, so
+ * the workers cannot use the object userdata to track how many procs
+ * are bound to each target - each worker instead keeps its own usage
+ * counters and scratch bitmaps, and anything that must be derived
+ * from the (shared) topology is computed up front on the calling
+ * thread.
+ *
+ * The result of bind_generic depends only on the topology, the cpus
+ * available to the job, the target depth, the locale of each of the
+ * job's procs (in order), and the objects already in use by other
+ * jobs. Most jobs land on nodes that match in all of these, so the
+ * bindings are only computed for the first node of each such class
+ * and then copied to the procs on the remaining nodes */
+typedef struct {
+    prte_node_t *node;
+    int target_depth;
+    /* cpus available to this job on the node - shared by all
+     * nodes of the job that have the same topology */
+    hwloc_cpuset_t available;
+    bool own_available;
+    /* the procs of this job on the node and their locales */
+    prte_proc_t **procs;
+    hwloc_obj_t *locales;
+    int nprocs;
+    /* false if procs from other jobs are already bound on the node,
+     * or the locales are incomplete, so the bindings must not be shared */
+    bool shareable;
+    /* index of the item whose bindings we copy, or -1 */
+    int rep;
+    int rc;
+} bind_item_t;
+
+typedef struct {
+    hwloc_cpuset_t totalcpuset;
+    /* #procs bound to each object at the target depth */
+    unsigned *usage;
+    unsigned nusage;
+} bind_scratch_t;
+
+typedef struct {
+    prte_job_t *jdata;
+    const char *job_cpuset;
+    int cpus_per_rank;
+    bool use_hwthread_cpus;
+    bind_item_t *items;
+    int nitems;
+    /* the items whose bindings are actually computed */
+    int *reps;
+    int nreps;
+    /* set when any worker hits an error so the others stop early */
+    volatile bool abort;
+} bind_job_t;
+
+typedef struct {
+    prte_thread_t thread;
+    bind_job_t *job;
+    int first;
+    int stride;
+    bind_scratch_t scratch;
+} bind_worker_t;
+
+/* show_help aggregates messages in unprotected lists, so calls
+ * from the binding workers must be serialized */
+static prte_mutex_t bind_lock = PRTE_MUTEX_STATIC_INIT;
+
+#define BIND_SHOW_HELP(...)                 \
+    do {                                    \
+        prte_mutex_lock(&bind_lock);        \
+        prte_show_help(__VA_ARGS__);        \
+        prte_mutex_unlock(&bind_lock);      \
+    } while (0)
+
+static int count_usage(prte_node_t *node, prte_jobid_t jobid,
+                       int target_depth, bind_scratch_t *scratch)
 {
     int j;
+    unsigned nobjs;
+    unsigned *tmp;
+    prte_proc_t *proc;
+    hwloc_obj_t bound;
+
+    nobjs = hwloc_get_nbobjs_by_depth(node->topology->topo, target_depth);
+    if (scratch->nusage < nobjs) {
+        tmp = (unsigned*)realloc(scratch->usage, nobjs * sizeof(unsigned));
+        if (NULL == tmp) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        scratch->usage = tmp;
+        scratch->nusage = nobjs;
+    }
+    memset(scratch->usage, 0, scratch->nusage * sizeof(unsigned));
+
+    /* record the objects already in use by procs from other jobs -
+     * only those at the target depth matter as that is all we look at */
+    for (j=0; j < node->procs->size; j++) {
+        if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
+            continue;
+        }
+        if (proc->name.jobid == jobid) {
+            continue;
+        }
+        if (NULL == (bound = (hwloc_obj_t)prte_get_attribute_ptr(&proc->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_PTR))) {
+            continue;
+        }
+        if (bound->depth != target_depth || nobjs <= bound->logical_index) {
+            continue;
+        }
+        scratch->usage[bound->logical_index]++;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* returns PRTE_ERR_TAKE_NEXT_OPTION if the default binding policy
+ * cannot be met on this node, in which case the caller must revert
+ * the whole job to not binding */
+static int bind_generic(bind_job_t *bj,
+                        bind_item_t *item,
+                        bind_scratch_t *scratch)
+{
+    int j, rc;
+    prte_job_t *jdata = bj->jdata;
+    prte_node_t *node = item->node;
+    int target_depth = item->target_depth;
     prte_job_map_t *map;
     prte_proc_t *proc;
     hwloc_obj_t trg_obj, tmp_obj, nxt_obj;
     unsigned int ncpus;
-    prte_hwloc_obj_data_t *data;
-    int total_cpus, cpus_per_rank;
-    hwloc_cpuset_t totalcpuset, available, mycpus;
+    int total_cpus;
+    hwloc_cpuset_t totalcpuset, available;
     hwloc_obj_t locale;
-    char *cpu_bitmap, *job_cpuset;
-    unsigned min_bound;
-    bool dobind, use_hwthread_cpus;
-    struct hwloc_topology_support *support;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *rdata;
-    uint16_t u16, *u16ptr = &u16;
+    char *cpu_bitmap;
+    unsigned min_bound, *num_bound;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                        "mca:rmaps: bind downward for job %s with bindings %s",
-                        PRTE_JOBID_PRINT(jdata->jobid),
+                        "mca:rmaps: bind downward for job %s on node %s with bindings %s",
+                        PRTE_JOBID_PRINT(jdata->jobid), node->name,
                         prte_hwloc_base_print_binding(jdata->map->binding));
     /* initialize */
     map = jdata->map;
-    totalcpuset = hwloc_bitmap_alloc();
-
-    dobind = false;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PRTE_BOOL)) {
-        dobind = true;
-    }
-    /* reset usage */
-    reset_usage(node, jdata->jobid);
+    totalcpuset = scratch->totalcpuset;
+    available = item->available;
 
-    /* get the available processors on this node */
-    root = hwloc_get_root_obj(node->topology->topo);
-    if (NULL == root->userdata) {
-        /* incorrect */
-        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-        return PRTE_ERR_BAD_PARAM;
-    }
-    rdata = (prte_hwloc_topo_data_t*)root->userdata;
-    available = hwloc_bitmap_dup(rdata->available);
-
-    /* see if they want multiple cpus/rank */
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PRTE_UINT16)) {
-        cpus_per_rank = u16;
-    } else {
-        cpus_per_rank = 1;
-    }
-
-    /* check for type of cpu being used */
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PRTE_BOOL)) {
-        use_hwthread_cpus = true;
-    } else {
-        use_hwthread_cpus = false;
-    }
-
-    /* see if this job has a "soft" cgroup assignment */
-    job_cpuset = NULL;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PRTE_STRING) &&
-        NULL != job_cpuset) {
-        mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
-        hwloc_bitmap_and(available, mycpus, available);
-        hwloc_bitmap_free(mycpus);
+    /* get the current usage */
+    if (PRTE_SUCCESS != (rc = count_usage(node, jdata->jobid, target_depth, scratch))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
     }
 
     /* cycle thru the procs */
@@ -221,71 +319,10 @@ static int bind_generic(prte_job_t *jdata,
         if (proc->name.jobid != jdata->jobid) {
             continue;
         }
-        if ((int)PRTE_PROC_MY_NAME->vpid != node->index && !dobind) {
-            continue;
-        }
-
-        if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL)) {
-            /* if we don't want to launch, then we are just testing the system,
-             * so ignore questions about support capabilities
-             */
-            support = (struct hwloc_topology_support*)hwloc_topology_get_support(node->topology->topo);
-            /* check if topology supports cpubind - have to be careful here
-             * as Linux doesn't currently support thread-level binding. This
-             * may change in the future, though, and it isn't clear how hwloc
-             * interprets the current behavior. So check both flags to be sure.
-             */
-            if (!support->cpubind->set_thisproc_cpubind &&
-                !support->cpubind->set_thisthread_cpubind) {
-                if (!PRTE_BINDING_REQUIRED(map->binding) ||
-                    !PRTE_BINDING_POLICY_IS_SET(map->binding)) {
-                    /* we are not required to bind, so ignore this */
-                    continue;
-                }
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                hwloc_bitmap_free(totalcpuset);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
-            }
-            /* check if topology supports membind - have to be careful here
-             * as hwloc treats this differently than I (at least) would have
-             * expected. Per hwloc, Linux memory binding is at the thread,
-             * and not process, level. Thus, hwloc sets the "thisproc" flag
-             * to "false" on all Linux systems, and uses the "thisthread" flag
-             * to indicate binding capability - don't warn if the user didn't
-             * specifically request binding
-             */
-            if (!support->membind->set_thisproc_membind &&
-                !support->membind->set_thisthread_membind &&
-                PRTE_BINDING_POLICY_IS_SET(map->binding)) {
-                if (PRTE_HWLOC_BASE_MBFA_WARN == prte_hwloc_base_mbfa && !membind_warned) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true, node->name);
-                    membind_warned = true;
-                } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
-                    return PRTE_ERR_SILENT;
-                }
-            }
-        }
 
         /* bozo check */
-        locale = NULL;
-        if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PRTE_PTR) ||
-            NULL == locale) {
-            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-locale", true, PRTE_NAME_PRINT(&proc->name));
-            hwloc_bitmap_free(totalcpuset);
-            hwloc_bitmap_free(available);
-            if (NULL != job_cpuset) {
-                free(job_cpuset);
-            }
+        if (NULL == (locale = (hwloc_obj_t)prte_get_attribute_ptr(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_PTR))) {
+            BIND_SHOW_HELP("help-prte-rmaps-base.txt", "rmaps:no-locale", true, PRTE_NAME_PRINT(&proc->name));
             return PRTE_ERR_SILENT;
         }
 
@@ -301,24 +338,14 @@ static int bind_generic(prte_job_t *jdata,
             if (!hwloc_bitmap_intersects(available, tmp_obj->cpuset))
                 continue;
 
-            data = (prte_hwloc_obj_data_t*)tmp_obj->userdata;
-            if (NULL == data) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                tmp_obj->userdata = data;
-            }
-            if (data->num_bound < min_bound) {
-                min_bound = data->num_bound;
+            if (scratch->usage[tmp_obj->logical_index] < min_bound) {
+                min_bound = scratch->usage[tmp_obj->logical_index];
                 trg_obj = tmp_obj;
             }
         }
         if (NULL == trg_obj) {
             /* there aren't any such targets under this object */
-            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
-            hwloc_bitmap_free(totalcpuset);
-            hwloc_bitmap_free(available);
-            if (NULL != job_cpuset) {
-                free(job_cpuset);
-            }
+            BIND_SHOW_HELP("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
             return PRTE_ERR_SILENT;
         }
         /* record the location */
@@ -331,69 +358,45 @@ static int bind_generic(prte_job_t *jdata,
         do {
             if (NULL == nxt_obj) {
                 /* could not find enough cpus to meet request */
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
-                hwloc_bitmap_free(totalcpuset);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
+                BIND_SHOW_HELP("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
                 return PRTE_ERR_SILENT;
             }
             trg_obj = nxt_obj;
             /* get the number of available cpus under this location */
-            ncpus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
+            ncpus = prte_hwloc_base_get_npus(node->topology->topo, bj->use_hwthread_cpus,
                                               available, trg_obj);
             /* track the number bound */
-            if (NULL == (data = (prte_hwloc_obj_data_t*)trg_obj->userdata)) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                trg_obj->userdata = data;
-            }
-            data->num_bound++;
+            num_bound = &scratch->usage[trg_obj->logical_index];
+            (*num_bound)++;
             /* error out if adding a proc would cause overload and that wasn't allowed,
              * and it wasn't a default binding policy (i.e., the user requested it)
              */
-            if (ncpus < data->num_bound &&
-                !PRTE_BIND_OVERLOAD_ALLOWED(jdata->map->binding)) {
-                if (PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
+            if (ncpus < *num_bound &&
+                !PRTE_BIND_OVERLOAD_ALLOWED(map->binding)) {
+                if (PRTE_BINDING_POLICY_IS_SET(map->binding)) {
                     /* if the user specified a binding policy, then we cannot meet
                      * it since overload isn't allowed, so error out - have the
                      * message indicate that setting overload allowed will remove
                      * this restriction */
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:binding-overload", true,
+                    BIND_SHOW_HELP("help-prte-rmaps-base.txt", "rmaps:binding-overload", true,
                                    prte_hwloc_base_print_binding(map->binding), node->name,
-                                   data->num_bound, ncpus);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
+                                   *num_bound, ncpus);
                     return PRTE_ERR_SILENT;
-                } else if (1 < cpus_per_rank) {
+                } else if (1 < bj->cpus_per_rank) {
                     /* if the user specified cpus/proc, then we weren't able
                      * to meet that request - this constitutes an error that
                      * must be reported */
-                    prte_show_help("help-prte-rmaps-base.txt", "insufficient-cpus-per-proc", true,
+                    BIND_SHOW_HELP("help-prte-rmaps-base.txt", "insufficient-cpus-per-proc", true,
                                    prte_hwloc_base_print_binding(map->binding), node->name,
-                                   (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
-                                   cpus_per_rank);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
+                                   (NULL != bj->job_cpuset) ? bj->job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
+                                   bj->cpus_per_rank);
                     return PRTE_ERR_SILENT;
                 } else {
                     /* if we have the default binding policy, then just don't bind */
                     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                                         "%s NOT ENOUGH CPUS TO COMPLETE BINDING - BINDING NOT REQUIRED, REVERTING TO NOT BINDING",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                    PRTE_SET_BINDING_POLICY(map->binding, PRTE_BIND_TO_NONE);
-                    unbind_procs(jdata);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
-                    return PRTE_SUCCESS;
+                    return PRTE_ERR_TAKE_NEXT_OPTION;
                 }
             }
             /* bind the proc here */
@@ -402,7 +405,7 @@ static int bind_generic(prte_job_t *jdata,
             total_cpus += ncpus;
             /* move to the next location, in case we need it */
             nxt_obj = trg_obj->next_cousin;
-        } while (total_cpus < cpus_per_rank);
+        } while (total_cpus < bj->cpus_per_rank);
         hwloc_bitmap_list_asprintf(&cpu_bitmap, totalcpuset);
         prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                             "%s PROC %s BITMAP %s",
@@ -414,7 +417,7 @@ static int bind_generic(prte_job_t *jdata,
         }
         if (4 < prte_output_get_verbosity(prte_rmaps_base_framework.framework_output)) {
             char *tmp1;
-            tmp1 = prte_hwloc_base_cset2str(totalcpuset, use_hwthread_cpus, node->topology->topo);
+            tmp1 = prte_hwloc_base_cset2str(totalcpuset, bj->use_hwthread_cpus, node->topology->topo);
             prte_output(prte_rmaps_base_framework.framework_output,
                         "%s BOUND PROC %s[%s] TO %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -422,12 +425,179 @@ static int bind_generic(prte_job_t *jdata,
             free(tmp1);
         }
     }
-    hwloc_bitmap_free(totalcpuset);
-    hwloc_bitmap_free(available);
-    if (NULL != job_cpuset) {
-        free(job_cpuset);
+
+    return PRTE_SUCCESS;
+}
+
+/* collect the procs of the job on the node, in the order bind_generic
+ * will visit them, and determine if their bindings can be shared */
+static int collect_procs(bind_item_t *item, prte_jobid_t jobid)
+{
+    prte_node_t *node = item->node;
+    prte_proc_t *proc;
+    hwloc_obj_t locale, bound;
+    int j;
+
+    item->procs = (prte_proc_t**)malloc(node->procs->size * sizeof(prte_proc_t*));
+    item->locales = (hwloc_obj_t*)malloc(node->procs->size * sizeof(hwloc_obj_t));
+    if (NULL == item->procs || NULL == item->locales) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    item->nprocs = 0;
+    item->shareable = true;
+    for (j=0; j < node->procs->size; j++) {
+        if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
+            continue;
+        }
+        if (proc->name.jobid != jobid) {
+            bound = (hwloc_obj_t)prte_get_attribute_ptr(&proc->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_PTR);
+            if (NULL != bound && bound->depth == item->target_depth) {
+                item->shareable = false;
+            }
+            continue;
+        }
+        if (NULL == (locale = (hwloc_obj_t)prte_get_attribute_ptr(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_PTR))) {
+            /* leave it to bind_generic to report */
+            item->shareable = false;
+        }
+        item->procs[item->nprocs] = proc;
+        item->locales[item->nprocs] = locale;
+        ++item->nprocs;
+    }
+    return PRTE_SUCCESS;
+}
+
+static bool same_bindings(bind_item_t *a, bind_item_t *b)
+{
+    if (!a->shareable || !b->shareable ||
+        a->node->topology != b->node->topology ||
+        a->target_depth != b->target_depth ||
+        a->available != b->available ||
+        a->nprocs != b->nprocs) {
+        return false;
+    }
+    /* the locales point into the shared topology, so
+     * matching pointers means matching objects */
+    return (0 == memcmp(a->locales, b->locales, a->nprocs * sizeof(hwloc_obj_t)));
+}
+
+static void stamp_bindings(bind_item_t *src, bind_item_t *dst)
+{
+    hwloc_obj_t bound;
+    const char *cpu_bitmap;
+    int k;
+
+    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps: node %s using bindings computed for node %s",
+                        dst->node->name, src->node->name);
+    for (k=0; k < dst->nprocs; k++) {
+        bound = NULL;
+        if (prte_get_attribute(&src->procs[k]->attributes, PRTE_PROC_HWLOC_BOUND, (void**)&bound, PRTE_PTR)) {
+            prte_set_attribute(&dst->procs[k]->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_ATTR_LOCAL, bound, PRTE_PTR);
+        }
+        cpu_bitmap = (const char*)prte_get_attribute_ptr(&src->procs[k]->attributes, PRTE_PROC_CPU_BITMAP, PRTE_STRING);
+        if (NULL != cpu_bitmap) {
+            prte_set_attribute(&dst->procs[k]->attributes, PRTE_PROC_CPU_BITMAP, PRTE_ATTR_GLOBAL, (void*)cpu_bitmap, PRTE_STRING);
+        }
+    }
+}
+
+static void *bind_worker(prte_object_t *obj)
+{
+    prte_thread_t *thread = (prte_thread_t*)obj;
+    bind_worker_t *wk = (bind_worker_t*)thread->t_arg;
+    bind_job_t *bj = wk->job;
+    bind_item_t *item;
+    int n;
+
+    for (n=wk->first; n < bj->nreps && !bj->abort; n += wk->stride) {
+        item = &bj->items[bj->reps[n]];
+        if (PRTE_SUCCESS != (item->rc = bind_generic(bj, item, &wk->scratch))) {
+            bj->abort = true;
+        }
+    }
+    return NULL;
+}
+
+static int bind_nodes(bind_job_t *bj)
+{
+    bind_worker_t *workers;
+    int nworkers, n, rc;
+
+    nworkers = prte_rmaps_base.bind_threads;
+    if (bj->nreps < nworkers) {
+        nworkers = bj->nreps;
+    }
+    if (nworkers < 1) {
+        nworkers = 1;
+    }
+    workers = (bind_worker_t*)calloc(nworkers, sizeof(bind_worker_t));
+    if (NULL == workers) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    if (1 < nworkers) {
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps: binding %d nodes for job %s using %d threads",
+                            bj->nreps, PRTE_JOBID_PRINT(bj->jdata->jobid), nworkers);
+    }
+
+    /* the calling thread acts as worker 0 */
+    for (n=0; n < nworkers; n++) {
+        PRTE_CONSTRUCT(&workers[n].thread, prte_thread_t);
+        workers[n].job = bj;
+        workers[n].first = n;
+        workers[n].stride = nworkers;
+        workers[n].scratch.totalcpuset = hwloc_bitmap_alloc();
+        workers[n].thread.t_run = bind_worker;
+        workers[n].thread.t_arg = &workers[n];
+    }
+    for (n=1; n < nworkers; n++) {
+        if (PRTE_SUCCESS != prte_thread_start(&workers[n].thread)) {
+            /* fall back to doing the work on this thread */
+            workers[n].thread.t_run = NULL;
+        }
+    }
+    bind_worker(&workers[0].thread.super);
+    for (n=1; n < nworkers; n++) {
+        if (NULL != workers[n].thread.t_run) {
+            prte_thread_join(&workers[n].thread, NULL);
+        } else {
+            bind_worker(&workers[n].thread.super);
+        }
+    }
+    for (n=0; n < nworkers; n++) {
+        hwloc_bitmap_free(workers[n].scratch.totalcpuset);
+        if (NULL != workers[n].scratch.usage) {
+            free(workers[n].scratch.usage);
+        }
+        PRTE_DESTRUCT(&workers[n].thread);
+    }
+    free(workers);
+
+    /* merge the results - report the first failure in node order */
+    rc = PRTE_SUCCESS;
+    for (n=0; n < bj->nitems; n++) {
+        if (PRTE_SUCCESS != bj->items[n].rc) {
+            rc = bj->items[n].rc;
+            break;
+        }
+    }
+    if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+        PRTE_SET_BINDING_POLICY(bj->jdata->map->binding, PRTE_BIND_TO_NONE);
+        unbind_procs(bj->jdata);
+        return PRTE_SUCCESS;
+    }
+    if (PRTE_SUCCESS != rc) {
+        return rc;
     }
 
+    /* copy the bindings to the nodes that share them */
+    for (n=0; n < bj->nitems; n++) {
+        if (0 > bj->items[n].rep) {
+            continue;
+        }
+        stamp_bindings(&bj->items[bj->items[n].rep], &bj->items[n]);
+    }
     return PRTE_SUCCESS;
 }
 
@@ -447,7 +617,8 @@ static int bind_in_place(prte_job_t *jdata,
     struct hwloc_topology_support *support;
     prte_hwloc_obj_data_t *data;
     hwloc_obj_t locale, sib;
-    char *cpu_bitmap, *job_cpuset;
+    char *cpu_bitmap;
+    const char *job_cpuset;
     bool found, use_hwthread_cpus;
     bool dobind;
     int cpus_per_rank;
@@ -463,17 +634,10 @@ static int bind_in_place(prte_job_t *jdata,
     /* initialize */
     map = jdata->map;
 
-    dobind = false;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PRTE_BOOL)) {
-        dobind = true;
-    }
+    dobind = prte_rmaps_base_binding_on_hnp(jdata);
 
     /* see if this job has a "soft" cgroup assignment */
-    job_cpuset = NULL;
-    prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PRTE_STRING);
+    job_cpuset = (const char*)prte_get_attribute_ptr(&jdata->attributes, PRTE_JOB_CPUSET, PRTE_STRING);
 
     /* see if they want multiple cpus/rank */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PRTE_UINT16)) {
@@ -514,9 +678,6 @@ static int bind_in_place(prte_job_t *jdata,
                     continue;
                 }
                 prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
                 return PRTE_ERR_SILENT;
             }
             /* check if topology supports membind - have to be careful here
@@ -535,9 +696,6 @@ static int bind_in_place(prte_job_t *jdata,
                     membind_warned = true;
                 } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
                     prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
                     return PRTE_ERR_SILENT;
                 }
             }
@@ -566,9 +724,6 @@ static int bind_in_place(prte_job_t *jdata,
         if (NULL == root->userdata) {
             /* incorrect */
             PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-            if (NULL != job_cpuset) {
-                free(job_cpuset);
-            }
             return PRTE_ERR_BAD_PARAM;
         }
         rdata = (prte_hwloc_topo_data_t*)root->userdata;
@@ -589,22 +744,15 @@ static int bind_in_place(prte_job_t *jdata,
                 continue;
             }
             /* bozo check */
-            locale = NULL;
-            if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PRTE_PTR)) {
+            if (NULL == (locale = (hwloc_obj_t)prte_get_attribute_ptr(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_PTR))) {
                 prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-locale", true, PRTE_NAME_PRINT(&proc->name));
                 hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
                 return PRTE_ERR_SILENT;
             }
             /* get the index of this location */
             if (UINT_MAX == (idx = prte_hwloc_base_get_obj_idx(node->topology->topo, locale))) {
                 PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
                 hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
                 return PRTE_ERR_SILENT;
             }
             /* get the number of cpus under this location */
@@ -612,9 +760,6 @@ static int bind_in_place(prte_job_t *jdata,
                                                         available, locale))) {
                 prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
                 hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
                 return PRTE_ERR_SILENT;
             }
             data = (prte_hwloc_obj_data_t*)locale->userdata;
@@ -680,9 +825,6 @@ static int bind_in_place(prte_job_t *jdata,
                                            prte_hwloc_base_print_binding(map->binding), node->name,
                                            data->num_bound, ncpus);
                             hwloc_bitmap_free(available);
-                            if (NULL != job_cpuset) {
-                                free(job_cpuset);
-                            }
                             return PRTE_ERR_SILENT;
                         } else if (1 < cpus_per_rank) {
                             /* if the user specified cpus/proc, then we weren't able
@@ -693,9 +835,6 @@ static int bind_in_place(prte_job_t *jdata,
                                            (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
                                            cpus_per_rank);
                             hwloc_bitmap_free(available);
-                            if (NULL != job_cpuset) {
-                                free(job_cpuset);
-                            }
                             return PRTE_ERR_SILENT;
                         } else {
                             /* if we have the default binding policy, then just don't bind */
@@ -704,9 +843,6 @@ static int bind_in_place(prte_job_t *jdata,
                                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
                             unbind_procs(jdata);
                             hwloc_bitmap_free(available);
-                            if (NULL != job_cpuset) {
-                                free(job_cpuset);
-                            }
                            return PRTE_SUCCESS;
                         }
                     }
@@ -743,9 +879,6 @@ static int bind_in_place(prte_job_t *jdata,
         }
         hwloc_bitmap_free(available);
     }
-    if (NULL != job_cpuset) {
-        free(job_cpuset);
-    }
 
     return PRTE_SUCCESS;
 }
@@ -760,7 +893,8 @@ static int bind_to_cpuset(prte_job_t *jdata)
     struct hwloc_topology_support *support;
     prte_hwloc_topo_data_t *sum;
     hwloc_obj_t root;
-    char *cpu_bitmap, *job_cpuset;
+    char *cpu_bitmap;
+    const char *job_cpuset;
     unsigned id;
     prte_local_rank_t lrank;
     hwloc_bitmap_t mycpuset, tset, mycpus;
@@ -768,9 +902,7 @@ static int bind_to_cpuset(prte_job_t *jdata)
     uint16_t u16, *u16ptr = &u16, ncpus, cpus_per_rank;
 
     /* see if this job has a "soft" cgroup assignment */
-    job_cpuset = NULL;
-    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PRTE_STRING) ||
-        NULL == job_cpuset) {
+    if (NULL == (job_cpuset = (const char*)prte_get_attribute_ptr(&jdata->attributes, PRTE_JOB_CPUSET, PRTE_STRING))) {
         return PRTE_ERR_BAD_PARAM;
     }
 
@@ -782,13 +914,7 @@ static int bind_to_cpuset(prte_job_t *jdata)
     map = jdata->map;
     mycpuset = hwloc_bitmap_alloc();
 
-    dobind = false;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PRTE_BOOL)) {
-        dobind = true;
-    }
+    dobind = prte_rmaps_base_binding_on_hnp(jdata);
 
 
     /* see if they want multiple cpus/rank */
@@ -829,7 +955,6 @@ static int bind_to_cpuset(prte_job_t *jdata)
                     continue;
                 }
                 prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                free(job_cpuset);
                 hwloc_bitmap_free(mycpuset);
                 return PRTE_ERR_SILENT;
             }
@@ -847,7 +972,6 @@ static int bind_to_cpuset(prte_job_t *jdata)
                     membind_warned = true;
                 } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
                     prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    free(job_cpuset);
                     hwloc_bitmap_free(mycpuset);
                     return PRTE_ERR_SILENT;
                 }
@@ -857,7 +981,6 @@ static int bind_to_cpuset(prte_job_t *jdata)
         if (NULL == root->userdata) {
             /* something went wrong */
             PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-            free(job_cpuset);
             hwloc_bitmap_free(mycpuset);
             return PRTE_ERR_NOT_FOUND;
         }
@@ -865,7 +988,6 @@ static int bind_to_cpuset(prte_job_t *jdata)
         if (NULL == sum->available) {
             /* another error */
             PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-            free(job_cpuset);
             hwloc_bitmap_free(mycpuset);
             return PRTE_ERR_NOT_FOUND;
         }
@@ -906,7 +1028,6 @@ static int bind_to_cpuset(prte_job_t *jdata)
                     /* ran out of cpus - that's an error */
                     prte_show_help("help-prte-rmaps-base.txt", "rmaps:insufficient-cpus", true,
                                    node->name, (int)proc->local_rank, job_cpuset);
-                    free(job_cpuset);
                     hwloc_bitmap_free(mycpuset);
                     hwloc_bitmap_free(mycpus);
                     return PRTE_ERR_OUT_OF_RESOURCE;
@@ -925,7 +1046,6 @@ static int bind_to_cpuset(prte_job_t *jdata)
         }
     }
     hwloc_bitmap_free(mycpuset);
-    free(job_cpuset);
     return PRTE_SUCCESS;
 }
 
@@ -938,8 +1058,14 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
     prte_node_t *node;
     int i, rc;
     struct hwloc_topology_support *support;
-    int bind_depth;
-    bool dobind;
+    int bind_depth, n;
+    bool dobind, nolaunch;
+    bind_job_t bj;
+    bind_item_t *item;
+    hwloc_obj_t root;
+    prte_hwloc_topo_data_t *rdata;
+    hwloc_cpuset_t mycpus;
+    uint16_t u16, *u16ptr = &u16;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                         "mca:rmaps: compute bindings for job %s with policy %s[%x]",
@@ -1031,14 +1157,37 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
                         "mca:rmaps: computing bindings for job %s",
                         PRTE_JOBID_PRINT(jdata->jobid));
 
-    dobind = false;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PRTE_BOOL) ||
-        prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PRTE_BOOL)) {
-        dobind = true;
+    dobind = prte_rmaps_base_binding_on_hnp(jdata);
+    nolaunch = prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL);
+
+    memset(&bj, 0, sizeof(bj));
+    bj.jdata = jdata;
+    /* see if they want multiple cpus/rank */
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PRTE_UINT16)) {
+        bj.cpus_per_rank = u16;
+    } else {
+        bj.cpus_per_rank = 1;
+    }
+    /* check for type of cpu being used */
+    bj.use_hwthread_cpus = prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PRTE_BOOL);
+    /* see if this job has a "soft" cgroup assignment */
+    bj.job_cpuset = (const char*)prte_get_attribute_ptr(&jdata->attributes, PRTE_JOB_CPUSET, PRTE_STRING);
+    bj.items = (bind_item_t*)calloc(jdata->map->nodes->size + 1, sizeof(bind_item_t));
+    bj.reps = (int*)calloc(jdata->map->nodes->size + 1, sizeof(int));
+    if (NULL == bj.items || NULL == bj.reps) {
+        if (NULL != bj.items) {
+            free(bj.items);
+        }
+        if (NULL != bj.reps) {
+            free(bj.reps);
+        }
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return PRTE_ERR_OUT_OF_RESOURCE;
     }
 
+    /* collect the nodes to be bound, doing everything that touches
+     * the topology userdata here on the calling thread */
+    rc = PRTE_SUCCESS;
     for (i=0; i < jdata->map->nodes->size; i++) {
         if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, i))) {
             continue;
@@ -1046,7 +1195,7 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
         if ((int)PRTE_PROC_MY_NAME->vpid != node->index && !dobind) {
             continue;
         }
-        if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PRTE_BOOL)) {
+        if (!nolaunch) {
             /* if we don't want to launch, then we are just testing the system,
              * so ignore questions about support capabilities
              */
@@ -1064,7 +1213,8 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
                     continue;
                 }
                 prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                return PRTE_ERR_SILENT;
+                rc = PRTE_ERR_SILENT;
+                goto cleanup;
             }
             /* check if topology supports membind - have to be careful here
              * as hwloc treats this differently than I (at least) would have
@@ -1082,7 +1232,8 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
                     membind_warned = true;
                 } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
                     prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    return PRTE_ERR_SILENT;
+                    rc = PRTE_ERR_SILENT;
+                    goto cleanup;
                 }
             }
         }
@@ -1119,17 +1270,79 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
             /* didn't find such an object */
             prte_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:no-objects",
                            true, hwloc_obj_type_string(hwb), node->name);
-            return PRTE_ERR_SILENT;
+            rc = PRTE_ERR_SILENT;
+            goto cleanup;
         }
         prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                             "%s bind_depth: %d",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             bind_depth);
-        if (PRTE_SUCCESS != (rc = bind_generic(jdata, node, bind_depth))) {
+
+        item = &bj.items[bj.nitems];
+        item->node = node;
+        item->target_depth = bind_depth;
+        item->rep = -1;
+        /* nodes with the same topology share the set of available cpus -
+         * the first node with each topology is always computed, so
+         * only the computed items need to be searched */
+        for (n=0; n < bj.nreps; n++) {
+            if (bj.items[bj.reps[n]].node->topology == node->topology) {
+                item->available = bj.items[bj.reps[n]].available;
+                break;
+            }
+        }
+        if (NULL == item->available) {
+            /* get the available processors on this node */
+            root = hwloc_get_root_obj(node->topology->topo);
+            if (NULL == root->userdata) {
+                /* incorrect */
+                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+                rc = PRTE_ERR_BAD_PARAM;
+                goto cleanup;
+            }
+            rdata = (prte_hwloc_topo_data_t*)root->userdata;
+            item->available = hwloc_bitmap_dup(rdata->available);
+            item->own_available = true;
+            if (NULL != bj.job_cpuset) {
+                mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, bj.use_hwthread_cpus, bj.job_cpuset);
+                hwloc_bitmap_and(item->available, mycpus, item->available);
+                hwloc_bitmap_free(mycpus);
+            }
+        }
+        if (PRTE_SUCCESS != (rc = collect_procs(item, jdata->jobid))) {
             PRTE_ERROR_LOG(rc);
-            return rc;
+            ++bj.nitems;
+            goto cleanup;
+        }
+        for (n=0; n < bj.nreps; n++) {
+            if (same_bindings(&bj.items[bj.reps[n]], item)) {
+                item->rep = bj.reps[n];
+                break;
+            }
+        }
+        if (0 > item->rep) {
+            bj.reps[bj.nreps++] = bj.nitems;
         }
+        ++bj.nitems;
     }
 
-    return PRTE_SUCCESS;
+    if (0 < bj.nitems && PRTE_SUCCESS != (rc = bind_nodes(&bj))) {
+        PRTE_ERROR_LOG(rc);
+    }
+
+  cleanup:
+    for (n=0; n < bj.nitems; n++) {
+        if (bj.items[n].own_available) {
+            hwloc_bitmap_free(bj.items[n].available);
+        }
+        if (NULL != bj.items[n].procs) {
+            free(bj.items[n].procs);
+        }
+        if (NULL != bj.items[n].locales) {
+            free(bj.items[n].locales);
+        }
+    }
+    free(bj.items);
+    free(bj.reps);
+    return rc;
 }
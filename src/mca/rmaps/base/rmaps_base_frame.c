@@ -58,6 +58,7 @@ prte_rmaps_base_t prte_rmaps_base = {{{0}}};
 static char *rmaps_base_mapping_policy = NULL;
 static char *rmaps_base_ranking_policy = NULL;
 static bool rmaps_base_inherit = false;
+static int rmaps_base_bind_threads = 1;
 
 static int prte_rmaps_base_register(prte_mca_base_register_flag_t flags)
 {
@@ -91,6 +92,14 @@ static int prte_rmaps_base_register(prte_mca_base_register_flag_t flags)
                                        PRTE_INFO_LVL_9,
                                        PRTE_MCA_BASE_VAR_SCOPE_READONLY, &rmaps_base_inherit);
 
+    rmaps_base_bind_threads = 1;
+    (void) prte_mca_base_var_register("prte", "rmaps", "default", "bind_threads",
+                                       "Number of threads to use when computing process bindings - the "
+                                       "nodes of a job are divided among the threads (default: 1)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY, &rmaps_base_bind_threads);
+
     return PRTE_SUCCESS;
 }
 
@@ -121,6 +130,7 @@ static int prte_rmaps_base_open(prte_mca_base_open_flag_t flags)
     prte_rmaps_base.ranking = 0;
     prte_rmaps_base.inherit = rmaps_base_inherit;
     prte_rmaps_base.hwthread_cpus = false;
+    prte_rmaps_base.bind_threads = rmaps_base_bind_threads;
     if (NULL == prte_set_slots) {
         prte_set_slots = strdup("core");
     }
@@ -478,6 +478,8 @@ void prte_rmaps_base_map_job(int fd, short args, void *cbdata)
     /* cycle thru the available mappers until one agrees to map
      * the job
      */
+    /* the mappers create a proc object for every rank */
+    prte_proc_slab_reserve(nprocs);
     did_map = false;
     if (1 == prte_list_get_size(&prte_rmaps_base.selected_modules)) {
         /* forced selection */
@@ -494,11 +496,13 @@ void prte_rmaps_base_map_job(int fd, short args, void *cbdata)
          * map the job. anything else is a true error.
          */
         if (PRTE_ERR_TAKE_NEXT_OPTION != rc) {
+            prte_proc_slab_retire();
             jdata->exit_code = rc;
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
     }
+    prte_proc_slab_retire();
 
     if (did_map && PRTE_ERR_RESOURCE_BUSY == rc) {
         /* the map was done but nothing could be mapped
@@ -132,6 +132,42 @@ int prte_rmaps_base_filter_nodes(prte_app_context_t *app,
 }
 
 
+static bool target_node_usable(prte_node_t *node, bool novm)
+{
+    /* ignore nodes that are non-usable */
+    if (PRTE_FLAG_TEST(node, PRTE_NODE_NON_USABLE)) {
+        return false;
+    }
+    /* ignore nodes that are marked as do-not-use for this mapping */
+    if (PRTE_NODE_STATE_DO_NOT_USE == node->state) {
+        PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_USE", node->name));
+        /* reset the state so it can be used another time */
+        node->state = PRTE_NODE_STATE_UP;
+        return false;
+    }
+    if (PRTE_NODE_STATE_DOWN == node->state) {
+        PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s IS DOWN", node->name));
+        return false;
+    }
+    if (PRTE_NODE_STATE_NOT_INCLUDED == node->state) {
+        PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_INCLUDE", node->name));
+        /* not to be used */
+        return false;
+    }
+    /* if this node wasn't included in the vm (e.g., by -host), ignore it,
+     * unless we are mapping prior to launching the vm
+     */
+    if (NULL == node->daemon && !novm) {
+        PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s HAS NO DAEMON", node->name));
+        return false;
+    }
+    return true;
+}
+
 /*
  * Query the registry for all nodes allocated to a specified app_context
  */
@@ -211,50 +247,13 @@ int prte_rmaps_base_get_target_nodes(prte_list_t *allocated_nodes, int32_t *tota
          * fully filled in - they only contain the user-provided
          * name of the node as a temp object. Thus, we cannot just
          * check to see if the node pointer matches that of a node
-         * in the node_pool.
+         * in the node_pool - look it up by name or alias instead.
          */
         PRTE_LIST_FOREACH_SAFE(nptr, next, &nodes, prte_node_t) {
-            for (i=0; i < prte_node_pool->size; i++) {
-                if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
-                    continue;
-                }
-                /* ignore nodes that are non-usable */
-                if (PRTE_FLAG_TEST(node, PRTE_NODE_NON_USABLE)) {
-                    continue;
-                }
-                /* ignore nodes that are marked as do-not-use for this mapping */
-                if (PRTE_NODE_STATE_DO_NOT_USE == node->state) {
-                    PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_USE", node->name));
-                    /* reset the state so it can be used another time */
-                    node->state = PRTE_NODE_STATE_UP;
-                    continue;
-                }
-                if (PRTE_NODE_STATE_DOWN == node->state) {
-                    PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS DOWN", node->name));
-                    continue;
-                }
-                if (PRTE_NODE_STATE_NOT_INCLUDED == node->state) {
-                    PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_INCLUDE", node->name));
-                    /* not to be used */
-                    continue;
-                }
-                /* if this node wasn't included in the vm (e.g., by -host), ignore it,
-                 * unless we are mapping prior to launching the vm
-                 */
-                if (NULL == node->daemon && !novm) {
-                    PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s HAS NO DAEMON", node->name));
-                    continue;
-                }
-                if (!prte_node_match(node, nptr->name)) {
-                    PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s DOESNT MATCH NODE %s",
-                                         node->name, nptr->name));
-                    continue;
-                }
+            if (NULL == (node = prte_node_lookup(nptr->name))) {
+                PRTE_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                                     "NODE %s NOT FOUND", nptr->name));
+            } else if (target_node_usable(node, novm)) {
                 /* retain a copy for our use in case the item gets
                  * destructed along the way
                  */
@@ -269,7 +268,6 @@ int prte_rmaps_base_get_target_nodes(prte_list_t *allocated_nodes, int32_t *tota
                 /* the list is ordered as per user direction using -host
                  * or the listing in -hostfile - preserve that ordering */
                 prte_list_append(allocated_nodes, &node->super);
-                break;
             }
             /* remove the item from the list as we have allocated it */
             prte_list_remove_item(&nodes, (prte_list_item_t*)nptr);
@@ -508,6 +506,95 @@ int prte_rmaps_base_get_target_nodes(prte_list_t *allocated_nodes, int32_t *tota
     return PRTE_SUCCESS;
 }
 
+static void tcl_con(prte_rmaps_base_topo_class_t *p)
+{
+    p->topology = NULL;
+    p->available = NULL;
+    p->nobjs = 0;
+    p->objs = NULL;
+    p->npus = NULL;
+}
+static void tcl_des(prte_rmaps_base_topo_class_t *p)
+{
+    if (NULL != p->available) {
+        hwloc_bitmap_free(p->available);
+    }
+    if (NULL != p->objs) {
+        free(p->objs);
+    }
+    if (NULL != p->npus) {
+        free(p->npus);
+    }
+}
+PRTE_CLASS_INSTANCE(prte_rmaps_base_topo_class_t,
+                    prte_list_item_t,
+                    tcl_con, tcl_des);
+
+prte_rmaps_base_topo_class_t* prte_rmaps_base_get_topo_class(prte_list_t *cache,
+                                                               prte_node_t *node,
+                                                               hwloc_obj_type_t target,
+                                                               unsigned cache_level,
+                                                               bool use_hwthread_cpus,
+                                                               const char *job_cpuset)
+{
+    prte_rmaps_base_topo_class_t *tcl;
+    hwloc_obj_t root;
+    prte_hwloc_topo_data_t *rdata;
+    hwloc_cpuset_t mycpus;
+    unsigned n;
+
+    PRTE_LIST_FOREACH(tcl, cache, prte_rmaps_base_topo_class_t) {
+        if (tcl->topology == node->topology &&
+            tcl->target == target &&
+            tcl->cache_level == cache_level) {
+            return tcl;
+        }
+    }
+
+    /* get the available processors on this node */
+    root = hwloc_get_root_obj(node->topology->topo);
+    if (NULL == root->userdata) {
+        /* incorrect */
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return NULL;
+    }
+    rdata = (prte_hwloc_topo_data_t*)root->userdata;
+
+    tcl = PRTE_NEW(prte_rmaps_base_topo_class_t);
+    tcl->topology = node->topology;
+    tcl->target = target;
+    tcl->cache_level = cache_level;
+    tcl->available = hwloc_bitmap_dup(rdata->available);
+    if (NULL != job_cpuset) {
+        /* deal with any "soft" cgroup specification */
+        mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
+        hwloc_bitmap_and(tcl->available, mycpus, tcl->available);
+        hwloc_bitmap_free(mycpus);
+    }
+    tcl->nobjs = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo, target, cache_level);
+    if (0 < tcl->nobjs) {
+        tcl->objs = (hwloc_obj_t*)malloc(tcl->nobjs * sizeof(hwloc_obj_t));
+        tcl->npus = (unsigned*)malloc(tcl->nobjs * sizeof(unsigned));
+        if (NULL == tcl->objs || NULL == tcl->npus) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            PRTE_RELEASE(tcl);
+            return NULL;
+        }
+        for (n=0; n < tcl->nobjs; n++) {
+            if (NULL == (tcl->objs[n] = prte_hwloc_base_get_obj_by_type(node->topology->topo, target, cache_level, n))) {
+                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+                PRTE_RELEASE(tcl);
+                return NULL;
+            }
+            tcl->npus[n] = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
+                                                    tcl->available, tcl->objs[n]);
+        }
+    }
+    prte_list_append(cache, &tcl->super);
+
+    return tcl;
+}
+
 prte_proc_t* prte_rmaps_base_setup_proc(prte_job_t *jdata,
                                           prte_node_t *node,
                                           prte_app_idx_t idx)
@@ -547,9 +634,52 @@ prte_proc_t* prte_rmaps_base_setup_proc(prte_job_t *jdata,
     /* retain the proc struct so that we correctly track its release */
     PRTE_RETAIN(proc);
 
+    if (PRTE_SUCCESS != (rc = prte_rmaps_base_count_proc(jdata, node, idx, 1))) {
+        PRTE_ERROR_LOG(rc);
+        return NULL;
+    }
+
     return proc;
 }
 
+/* track the number of procs from each app_context on each node */
+int prte_rmaps_base_count_proc(prte_job_t *jdata,
+                               prte_node_t *node,
+                               prte_app_idx_t idx,
+                               int delta)
+{
+    prte_job_map_t *map = jdata->map;
+    uint16_t *ppn;
+    int32_t stride;
+    prte_app_idx_t n;
+
+    if (NULL == map || idx >= jdata->num_apps || 0 > node->index) {
+        return PRTE_ERR_BAD_PARAM;
+    }
+    if (NULL == map->ppn || map->ppn_stride <= node->index) {
+        /* size it for the entire pool so we only do this once */
+        stride = prte_node_pool->size;
+        if (stride <= node->index) {
+            stride = node->index + 1;
+        }
+        ppn = (uint16_t*)calloc(jdata->num_apps * stride, sizeof(uint16_t));
+        if (NULL == ppn) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        if (NULL != map->ppn) {
+            for (n=0; n < jdata->num_apps; n++) {
+                memcpy(&ppn[n * stride], &map->ppn[n * map->ppn_stride],
+                       map->ppn_stride * sizeof(uint16_t));
+            }
+            free(map->ppn);
+        }
+        map->ppn = ppn;
+        map->ppn_stride = stride;
+    }
+    map->ppn[idx * map->ppn_stride + node->index] += delta;
+    return PRTE_SUCCESS;
+}
+
 /*
  * determine the proper starting point for the next mapping operation
  */
@@ -53,6 +53,38 @@ PRTE_EXPORT prte_proc_t* prte_rmaps_base_setup_proc(prte_job_t *jdata,
                                                       prte_node_t *node,
                                                       prte_app_idx_t idx);
 
+PRTE_EXPORT int prte_rmaps_base_count_proc(prte_job_t *jdata,
+                                           prte_node_t *node,
+                                           prte_app_idx_t idx,
+                                           int delta);
+
+/* Nodes with identical hardware share a single prte_topology_t, so
+ * anything a mapper derives from the topology alone - the objects
+ * of the target type and the number of cpus the job may use under
+ * each of them - only needs to be computed once per distinct
+ * topology. Mappers keep a list of these for the duration of a
+ * mapping operation and look them up by node */
+typedef struct {
+    prte_list_item_t super;
+    prte_topology_t *topology;
+    hwloc_obj_type_t target;
+    unsigned cache_level;
+    /* cpus on the node available to the job */
+    hwloc_cpuset_t available;
+    unsigned nobjs;
+    hwloc_obj_t *objs;
+    /* #cpus available to the job under each object */
+    unsigned *npus;
+} prte_rmaps_base_topo_class_t;
+PRTE_CLASS_DECLARATION(prte_rmaps_base_topo_class_t);
+
+PRTE_EXPORT prte_rmaps_base_topo_class_t* prte_rmaps_base_get_topo_class(prte_list_t *cache,
+                                                                           prte_node_t *node,
+                                                                           hwloc_obj_type_t target,
+                                                                           unsigned cache_level,
+                                                                           bool use_hwthread_cpus,
+                                                                           const char *job_cpuset);
+
 PRTE_EXPORT prte_node_t* prte_rmaps_base_get_starting_point(prte_list_t *node_list,
                                                               prte_job_t *jdata);
 
@@ -62,6 +94,8 @@ PRTE_EXPORT int prte_rmaps_base_compute_local_ranks(prte_job_t *jdata);
 
 PRTE_EXPORT int prte_rmaps_base_compute_bindings(prte_job_t *jdata);
 
+PRTE_EXPORT bool prte_rmaps_base_binding_on_hnp(prte_job_t *jdata);
+
 PRTE_EXPORT void prte_rmaps_base_update_local_ranks(prte_job_t *jdata, prte_node_t *oldnode,
                                                       prte_node_t *newnode, prte_proc_t *newproc);
 
@@ -90,6 +90,8 @@ static int ppr_mapper(prte_job_t *jdata)
     char **ppr_req, **ck, *jobppr=NULL;
     size_t len;
     bool initial_map=true;
+    prte_list_t classes;
+    prte_rmaps_base_topo_class_t *tcl;
 
     /* only handle initial launch of loadbalanced
      * or NPERxxx jobs - allow restarting of failed apps
@@ -233,6 +235,9 @@ static int ppr_mapper(prte_job_t *jdata)
     level = start;
     lowest = prte_hwloc_levels[start];
 
+    /* nodes that share a topology also share the list of objects we map to */
+    PRTE_CONSTRUCT(&classes, prte_list_t);
+
     for (idx=0; idx < (prte_app_idx_t)jdata->apps->size; idx++) {
         if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, idx))) {
             continue;
@@ -295,16 +300,19 @@ static int ppr_mapper(prte_job_t *jdata)
                     prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_ATTR_LOCAL, obj, PRTE_PTR);
                 }
             } else {
-                /* get the number of lowest resources on this node */
-                nobjs = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo,
-                                                           lowest, cache_level);
+                /* get the lowest resources on this node */
+                if (NULL == (tcl = prte_rmaps_base_get_topo_class(&classes, node, lowest, cache_level,
+                                                                  false, NULL))) {
+                    rc = PRTE_ERR_BAD_PARAM;
+                    goto error;
+                }
+                nobjs = tcl->nobjs;
 
                 /* map the specified number of procs to each such resource on this node,
                  * recording the locale of each proc so we know its cpuset
                  */
                 for (i=0; i < nobjs; i++) {
-                    obj = prte_hwloc_base_get_obj_by_type(node->topology->topo,
-                                                          lowest, cache_level, i);
+                    obj = tcl->objs[i];
                     for (j=0; j < ppr[start] && nprocs_mapped < total_procs; j++) {
                         if (NULL == (proc = prte_rmaps_base_setup_proc(jdata, node, idx))) {
                             rc = PRTE_ERR_OUT_OF_RESOURCE;
@@ -400,11 +408,13 @@ static int ppr_mapper(prte_job_t *jdata)
 
         PRTE_LIST_DESTRUCT(&node_list);
     }
+    PRTE_LIST_DESTRUCT(&classes);
     free(jobppr);
     return PRTE_SUCCESS;
 
   error:
     PRTE_LIST_DESTRUCT(&node_list);
+    PRTE_LIST_DESTRUCT(&classes);
     free(jobppr);
     return rc;
 }
@@ -588,6 +598,7 @@ static void prune(prte_jobid_t jobid,
                                 "mca:rmaps:ppr: removing proc at posn %d",
                                 idxmax);
             prte_pointer_array_set_item(node->procs, idxmax, NULL);
+            prte_rmaps_base_count_proc(procmax->job, node, procmax->app_idx, -1);
             node->num_procs--;
             node->slots_inuse--;
             if (node->slots_inuse < 0) {
@@ -69,6 +69,12 @@ struct prte_job_map_t {
     int32_t num_nodes;
     /* array of pointers to nodes in this map for this job */
     prte_pointer_array_t *nodes;
+    /* number of procs from each app_context placed on each node,
+     * indexed by (app_idx * ppn_stride + node->index) - maintained
+     * by the mapper as procs are placed so the launch message
+     * doesn't have to scan the node's procs */
+    uint16_t *ppn;
+    int32_t ppn_stride;
 };
 typedef struct prte_job_map_t prte_job_map_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_job_map_t);
@@ -95,7 +95,7 @@ int prte_rmaps_rr_assign_byobj(prte_job_t *jdata,
     hwloc_obj_t obj=NULL, root;
     unsigned int nobjs;
     uint16_t u16, *u16ptr = &u16;
-    char *job_cpuset;
+    const char *job_cpuset;
     prte_hwloc_topo_data_t *rdata;
     hwloc_cpuset_t available, mycpus;
     bool use_hwthread_cpus;
@@ -106,8 +106,7 @@ int prte_rmaps_rr_assign_byobj(prte_job_t *jdata,
                         PRTE_JOBID_PRINT(jdata->jobid));
 
     /* see if this job has a "soft" cgroup assignment */
-    job_cpuset = NULL;
-    prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PRTE_STRING);
+    job_cpuset = (const char*)prte_get_attribute_ptr(&jdata->attributes, PRTE_JOB_CPUSET, PRTE_STRING);
 
     /* see if they want multiple cpus/rank */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PRTE_UINT16)) {
@@ -151,9 +150,6 @@ int prte_rmaps_rr_assign_byobj(prte_job_t *jdata,
             if (NULL == root->userdata) {
                 /* incorrect */
                 PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
                 return PRTE_ERR_BAD_PARAM;
             }
             rdata = (prte_hwloc_topo_data_t*)root->userdata;
@@ -200,9 +196,6 @@ int prte_rmaps_rr_assign_byobj(prte_job_t *jdata,
                 if (NULL == (obj = prte_hwloc_base_get_obj_by_type(node->topology->topo, target, cache_level, (j + start) % nobjs))) {
                     PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
                     hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
                     return PRTE_ERR_NOT_FOUND;
                 }
                 npus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
@@ -212,9 +205,6 @@ int prte_rmaps_rr_assign_byobj(prte_job_t *jdata,
                                    cpus_per_rank, npus,
                                    prte_rmaps_base_print_mapping(prte_rmaps_base.mapping));
                     hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
                     return PRTE_ERR_SILENT;
                 }
                 prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_ATTR_LOCAL, obj, PRTE_PTR);
@@ -224,8 +214,5 @@ int prte_rmaps_rr_assign_byobj(prte_job_t *jdata,
             hwloc_bitmap_free(available);
         }
     }
-    if (NULL != job_cpuset) {
-        free(job_cpuset);
-    }
     return PRTE_SUCCESS;
 }
@@ -455,16 +455,18 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
     int i, nmapped, nprocs_mapped;
     prte_node_t *node;
     int nprocs, start, cpus_per_rank, npus;
-    hwloc_obj_t obj=NULL, root;
+    hwloc_obj_t obj=NULL;
     unsigned int nobjs;
     bool add_one;
     bool second_pass, use_hwthread_cpus;
     prte_proc_t *proc;
     uint16_t u16, *u16ptr = &u16;
-    char *job_cpuset;
-    prte_hwloc_topo_data_t *rdata;
-    hwloc_cpuset_t available, mycpus;
+    const char *job_cpuset;
+    hwloc_cpuset_t available;
     bool found_obj;
+    prte_list_t classes;
+    prte_rmaps_base_topo_class_t *tcl;
+    int rc;
 
     /* there are two modes for mapping by object: span and not-span. The
      * span mode essentially operates as if there was just a single
@@ -502,8 +504,7 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
     }
 
     /* see if this job has a "soft" cgroup assignment */
-    job_cpuset = NULL;
-    prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PRTE_STRING);
+    job_cpuset = (const char*)prte_get_attribute_ptr(&jdata->attributes, PRTE_JOB_CPUSET, PRTE_STRING);
 
     /* see if they want multiple cpus/rank */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PRTE_UINT16)) {
@@ -524,6 +525,8 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
      * all procs are mapped. If one pass doesn't catch all the required procs,
      * then loop thru the list again to handle the oversubscription
      */
+    PRTE_CONSTRUCT(&classes, prte_list_t);
+    rc = PRTE_SUCCESS;
     nprocs_mapped = 0;
     second_pass = false;
     do {
@@ -532,11 +535,18 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
             if (NULL == node->topology || NULL == node->topology->topo) {
                 prte_show_help("help-prte-rmaps-ppr.txt", "ppr-topo-missing",
                                true, node->name);
-                return PRTE_ERR_SILENT;
+                rc = PRTE_ERR_SILENT;
+                goto cleanup;
             }
             start = 0;
-            /* get the number of objects of this type on this node */
-            nobjs = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo, target, cache_level);
+            /* get the objects of this type on this node, and the cpus
+             * available to us under each of them */
+            if (NULL == (tcl = prte_rmaps_base_get_topo_class(&classes, node, target, cache_level,
+                                                              use_hwthread_cpus, job_cpuset))) {
+                rc = PRTE_ERR_BAD_PARAM;
+                goto cleanup;
+            }
+            nobjs = tcl->nobjs;
             if (0 == nobjs) {
                 continue;
             }
@@ -568,21 +578,7 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
                     continue;
                 }
             }
-            /* get the available processors on this node */
-            root = hwloc_get_root_obj(node->topology->topo);
-            if (NULL == root->userdata) {
-                /* incorrect */
-                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-                return PRTE_ERR_BAD_PARAM;
-            }
-            rdata = (prte_hwloc_topo_data_t*)root->userdata;
-            available = hwloc_bitmap_dup(rdata->available);
-            if (NULL != job_cpuset) {
-                /* deal with any "soft" cgroup specification */
-                mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
-                  hwloc_bitmap_and(available, mycpus, available);
-                hwloc_bitmap_free(mycpus);
-            }
+            available = tcl->available;
 
             /* add this node to the map, if reqd */
             if (!PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_MAPPED)) {
@@ -602,16 +598,8 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
                     prte_output_verbose(10, prte_rmaps_base_framework.framework_output,
                                         "mca:rmaps:rr: assigning proc to object %d", (i+start) % nobjs);
                     /* get the hwloc object */
-                    if (NULL == (obj = prte_hwloc_base_get_obj_by_type(node->topology->topo, target, cache_level, (i+start) % nobjs))) {
-                        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                        hwloc_bitmap_free(available);
-                        if (NULL != job_cpuset) {
-                            free(job_cpuset);
-                        }
-                        return PRTE_ERR_NOT_FOUND;
-                    }
-                    npus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
-                                                     available, obj);
+                    obj = tcl->objs[(i+start) % nobjs];
+                    npus = tcl->npus[(i+start) % nobjs];
                     if (0 == npus) {
                         continue;
                     }
@@ -620,18 +608,12 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
                         prte_show_help("help-prte-rmaps-base.txt", "mapping-too-low", true,
                                        cpus_per_rank, npus,
                                        prte_rmaps_base_print_mapping(prte_rmaps_base.mapping));
-                        hwloc_bitmap_free(available);
-                        if (NULL != job_cpuset) {
-                            free(job_cpuset);
-                        }
-                        return PRTE_ERR_SILENT;
+                        rc = PRTE_ERR_SILENT;
+                        goto cleanup;
                     }
                     if (NULL == (proc = prte_rmaps_base_setup_proc(jdata, node, app->idx))) {
-                        hwloc_bitmap_free(available);
-                        if (NULL != job_cpuset) {
-                            free(job_cpuset);
-                        }
-                        return PRTE_ERR_OUT_OF_RESOURCE;
+                        rc = PRTE_ERR_OUT_OF_RESOURCE;
+                        goto cleanup;
                     }
                     nprocs_mapped++;
                     nmapped++;
@@ -647,14 +629,10 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
                                prte_rmaps_base_print_mapping(prte_rmaps_base.mapping),
                                (NULL == prte_hwloc_default_cpu_list) ? "N/A" : prte_hwloc_default_cpu_list,
                                (NULL == job_cpuset) ? "N/A" : job_cpuset, err);
-                hwloc_bitmap_free(available);
                 free(err);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
+                rc = PRTE_ERR_SILENT;
+                goto cleanup;
             }
-            hwloc_bitmap_free(available);
             add_one = true;
             /* not all nodes are equal, so only set oversubscribed for
              * this node if it is in that state
@@ -674,19 +652,15 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
                         prte_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:alloc-error",
                                        true, app->num_procs, app->app, prte_process_info.nodename);
                         PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
-                        if (NULL != job_cpuset) {
-                            free(job_cpuset);
-                        }
-                        return PRTE_ERR_SILENT;
+                        rc = PRTE_ERR_SILENT;
+                        goto cleanup;
                     } else if (PRTE_MAPPING_NO_OVERSUBSCRIBE & PRTE_GET_MAPPING_DIRECTIVE(jdata->map->mapping)) {
                         /* if we were explicitly told not to oversubscribe, then don't */
                         prte_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:alloc-error",
                                        true, app->num_procs, app->app, prte_process_info.nodename);
                         PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
-                        if (NULL != job_cpuset) {
-                            free(job_cpuset);
-                        }
-                        return PRTE_ERR_SILENT;
+                        rc = PRTE_ERR_SILENT;
+                        goto cleanup;
                     }
                 }
             }
@@ -698,16 +672,14 @@ int prte_rmaps_rr_byobj(prte_job_t *jdata,
         second_pass = true;
     } while (add_one && nprocs_mapped < app->num_procs);
 
-    if (NULL != job_cpuset) {
-        free(job_cpuset);
-    }
-
     if (nprocs_mapped < app->num_procs) {
         /* usually means there were no objects of the requested type */
-        return PRTE_ERR_NOT_FOUND;
+        rc = PRTE_ERR_NOT_FOUND;
     }
 
-    return PRTE_SUCCESS;
+  cleanup:
+    PRTE_LIST_DESTRUCT(&classes);
+    return rc;
 }
 
 static int byobj_span(prte_job_t *jdata,
@@ -720,14 +692,15 @@ static int byobj_span(prte_job_t *jdata,
     int i, j, nprocs_mapped, navg;
     prte_node_t *node;
     int nprocs, nxtra_objs, npus, cpus_per_rank;
-    hwloc_obj_t obj=NULL, root;
+    hwloc_obj_t obj=NULL;
     unsigned int nobjs;
     prte_proc_t *proc;
     uint16_t u16, *u16ptr = &u16;
-    char *job_cpuset;
-    prte_hwloc_topo_data_t *rdata;
-    hwloc_cpuset_t available, mycpus;
+    const char *job_cpuset;
     bool use_hwthread_cpus;
+    prte_list_t classes;
+    prte_rmaps_base_topo_class_t *tcl;
+    int rc;
 
     prte_output_verbose(2, prte_rmaps_base_framework.framework_output,
                         "mca:rmaps:rr: mapping span by %s for job %s slots %d num_procs %lu",
@@ -764,8 +737,7 @@ static int byobj_span(prte_job_t *jdata,
     }
 
     /* see if this job has a "soft" cgroup assignment */
-    job_cpuset = NULL;
-    prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PRTE_STRING);
+    job_cpuset = (const char*)prte_get_attribute_ptr(&jdata->attributes, PRTE_JOB_CPUSET, PRTE_STRING);
 
     /* see if they want multiple cpus/rank */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PRTE_UINT16)) {
@@ -800,6 +772,8 @@ static int byobj_span(prte_job_t *jdata,
                         hwloc_obj_type_string(target),
                         navg, nxtra_objs);
 
+    PRTE_CONSTRUCT(&classes, prte_list_t);
+    rc = PRTE_SUCCESS;
     nprocs_mapped = 0;
     PRTE_LIST_FOREACH(node, node_list, prte_node_t) {
         /* add this node to the map, if reqd */
@@ -809,50 +783,27 @@ static int byobj_span(prte_job_t *jdata,
             prte_pointer_array_add(jdata->map->nodes, node);
             ++(jdata->map->num_nodes);
         }
-        /* get the available processors on this node */
-        root = hwloc_get_root_obj(node->topology->topo);
-        if (NULL == root->userdata) {
-            /* incorrect */
-            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-            if (NULL != job_cpuset) {
-                free(job_cpuset);
-            }
-            return PRTE_ERR_BAD_PARAM;
-        }
-        rdata = (prte_hwloc_topo_data_t*)root->userdata;
-        available = hwloc_bitmap_dup(rdata->available);
-        if (NULL != job_cpuset) {
-            /* deal with any "soft" cgroup specification */
-            mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
-            hwloc_bitmap_and(available, mycpus, available);
-            hwloc_bitmap_free(mycpus);
+        /* get the objects of this type on this node, and the cpus
+         * available to us under each of them */
+        if (NULL == (tcl = prte_rmaps_base_get_topo_class(&classes, node, target, cache_level,
+                                                          use_hwthread_cpus, job_cpuset))) {
+            rc = PRTE_ERR_BAD_PARAM;
+            goto cleanup;
         }
-        /* get the number of objects of this type on this node */
-        nobjs = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo, target, cache_level);
+        nobjs = tcl->nobjs;
         prte_output_verbose(2, prte_rmaps_base_framework.framework_output,
                             "mca:rmaps:rr:byobj: found %d objs on node %s", nobjs, node->name);
         /* loop through the number of objects */
         for (i=0; i < (int)nobjs && nprocs_mapped < (int)app->num_procs; i++) {
             /* get the hwloc object */
-            if (NULL == (obj = prte_hwloc_base_get_obj_by_type(node->topology->topo, target, cache_level, i))) {
-                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_NOT_FOUND;
-            }
-            npus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
-                                             available, obj);
+            obj = tcl->objs[i];
+            npus = tcl->npus[i];
             if (cpus_per_rank > npus) {
                 prte_show_help("help-prte-rmaps-base.txt", "mapping-too-low", true,
                                cpus_per_rank, npus,
                                prte_rmaps_base_print_mapping(prte_rmaps_base.mapping));
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
+                rc = PRTE_ERR_SILENT;
+                goto cleanup;
             }
             /* determine how many to map */
             nprocs = navg;
@@ -863,7 +814,8 @@ static int byobj_span(prte_job_t *jdata,
             /* map the reqd number of procs */
             for (j=0; j < nprocs && nprocs_mapped < app->num_procs; j++) {
                 if (NULL == (proc = prte_rmaps_base_setup_proc(jdata, node, app->idx))) {
-                    return PRTE_ERR_OUT_OF_RESOURCE;
+                    rc = PRTE_ERR_OUT_OF_RESOURCE;
+                    goto cleanup;
                 }
                 nprocs_mapped++;
                 prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_ATTR_LOCAL, obj, PRTE_PTR);
@@ -885,11 +837,9 @@ static int byobj_span(prte_job_t *jdata,
             /* we are done */
             break;
         }
-        hwloc_bitmap_free(available);
-    }
-    if (NULL != job_cpuset) {
-        free(job_cpuset);
     }
 
-    return PRTE_SUCCESS;
+  cleanup:
+    PRTE_LIST_DESTRUCT(&classes);
+    return rc;
 }
@@ -46,6 +46,7 @@
 #include "src/dss/dss_types.h"
 #include "src/mca/mca.h"
 #include "src/class/prte_pointer_array.h"
+#include "src/class/prte_hash_table.h"
 
 #include "src/runtime/prte_globals.h"
 #include "src/mca/routed/routed.h"
@@ -68,8 +69,9 @@ PRTE_EXPORT int prte_rml_base_select(void);
 
 /* a global struct containing framework-level values */
 typedef struct {
-    prte_list_t posted_recvs;
-    prte_list_t unmatched_msgs;
+    /* posted recvs and unmatched msgs, indexed by
+     * tag - each entry is a prte_rml_tag_bucket_t */
+    prte_hash_table_t tags;
     int max_retries;
 } prte_rml_base_t;
 PRTE_EXPORT extern prte_rml_base_t prte_rml_base;
@@ -121,6 +123,7 @@ typedef struct {
     prte_rml_tag_t tag;          // targeted tag
     uint32_t seq_num;             //sequence number
     struct iovec iov;            // the recvd data
+    size_t offset;               // leading bytes of the data already consumed
 } prte_rml_recv_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_rml_recv_t);
 
@@ -138,6 +141,17 @@ typedef struct {
 } prte_rml_posted_recv_t;
 PRTE_CLASS_DECLARATION(prte_rml_posted_recv_t);
 
+/* per-tag holder of the posted recvs and the unmatched msgs
+ * for that tag - both lists are maintained in arrival order
+ * so the matching semantics are those of a single global list */
+typedef struct {
+    prte_object_t super;
+    prte_rml_tag_t tag;
+    prte_list_t posted_recvs;
+    prte_list_t unmatched_msgs;
+} prte_rml_tag_bucket_t;
+PRTE_CLASS_DECLARATION(prte_rml_tag_bucket_t);
+
 /* define an object for transferring recv requests to the list of posted recvs */
 typedef struct {
     prte_object_t super;
@@ -185,6 +199,34 @@ PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_self_send_xfer_t);
         prte_event_active(&msg->ev, PRTE_EV_WRITE, 1);                  \
     } while(0);
 
+/* post the unpacked portion of a buffer for local delivery
+ * without copying it - the buffer's storage is transferred to
+ * the message and the buffer is left empty */
+#define PRTE_RML_POST_BUFFER(p, t, s, b)                                \
+    do {                                                                \
+        prte_rml_recv_t *msg;                                           \
+        prte_output_verbose(5, prte_rml_base_framework.framework_output, \
+                            "%s Buffer posted at %s:%d for tag %d",     \
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),         \
+                            __FILE__, __LINE__, (t));                   \
+        msg = PRTE_NEW(prte_rml_recv_t);                                 \
+        msg->sender.jobid = (p)->jobid;                                 \
+        msg->sender.vpid = (p)->vpid;                                   \
+        msg->tag = (t);                                                 \
+        msg->seq_num = (s);                                             \
+        msg->iov.iov_base = (IOVBASE_TYPE*)(b)->base_ptr;               \
+        msg->iov.iov_len = (b)->bytes_used;                             \
+        msg->offset = (b)->unpack_ptr - (b)->base_ptr;                  \
+        (b)->base_ptr = NULL;                                           \
+        (b)->bytes_used = 0;                                            \
+        /* setup the event */                                           \
+        prte_event_set(prte_event_base, &msg->ev, -1,                   \
+                       PRTE_EV_WRITE,                                   \
+                       prte_rml_base_process_msg, msg);                 \
+        prte_event_set_priority(&msg->ev, PRTE_MSG_PRI);                \
+        prte_event_active(&msg->ev, PRTE_EV_WRITE, 1);                  \
+    } while(0);
+
 #define PRTE_RML_ACTIVATE_MESSAGE(m)                            \
     do {                                                        \
         /* setup the event */                                   \
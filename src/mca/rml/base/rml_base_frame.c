@@ -59,7 +59,21 @@ static int prte_rml_base_register(prte_mca_base_register_flag_t flags)
 
 static int prte_rml_base_close(void)
 {
-    PRTE_LIST_DESTRUCT(&prte_rml_base.posted_recvs);
+    prte_rml_tag_bucket_t *bucket;
+    uint32_t key;
+    void *node;
+    int rc;
+
+    rc = prte_hash_table_get_first_key_uint32(&prte_rml_base.tags, &key,
+                                              (void **)&bucket, &node);
+    while (PRTE_SUCCESS == rc) {
+        if (NULL != bucket) {
+            PRTE_RELEASE(bucket);
+        }
+        rc = prte_hash_table_get_next_key_uint32(&prte_rml_base.tags, &key,
+                                                 (void **)&bucket, node, &node);
+    }
+    PRTE_DESTRUCT(&prte_rml_base.tags);
     return prte_mca_base_framework_components_close(&prte_rml_base_framework, NULL);
 }
 
@@ -67,8 +81,8 @@ static int prte_rml_base_open(prte_mca_base_open_flag_t flags)
 {
     /* Initialize globals */
     /* construct object for holding the active plugin modules */
-    PRTE_CONSTRUCT(&prte_rml_base.posted_recvs, prte_list_t);
-    PRTE_CONSTRUCT(&prte_rml_base.unmatched_msgs, prte_list_t);
+    PRTE_CONSTRUCT(&prte_rml_base.tags, prte_hash_table_t);
+    prte_hash_table_init(&prte_rml_base.tags, 128);
 
     /* Open up all available components */
     return prte_mca_base_framework_components_open(&prte_rml_base_framework, flags);
@@ -187,6 +201,7 @@ static void recv_cons(prte_rml_recv_t *ptr)
 {
     ptr->iov.iov_base = NULL;
     ptr->iov.iov_len = 0;
+    ptr->offset = 0;
 }
 static void recv_des(prte_rml_recv_t *ptr)
 {
@@ -218,6 +233,21 @@ PRTE_CLASS_INSTANCE(prte_rml_posted_recv_t,
                    prte_list_item_t,
                    prcv_cons, NULL);
 
+static void tbkt_cons(prte_rml_tag_bucket_t *ptr)
+{
+    ptr->tag = PRTE_RML_TAG_INVALID;
+    PRTE_CONSTRUCT(&ptr->posted_recvs, prte_list_t);
+    PRTE_CONSTRUCT(&ptr->unmatched_msgs, prte_list_t);
+}
+static void tbkt_des(prte_rml_tag_bucket_t *ptr)
+{
+    PRTE_LIST_DESTRUCT(&ptr->posted_recvs);
+    PRTE_LIST_DESTRUCT(&ptr->unmatched_msgs);
+}
+PRTE_CLASS_INSTANCE(prte_rml_tag_bucket_t,
+                   prte_object_t,
+                   tbkt_cons, tbkt_des);
+
 static void prq_cons(prte_rml_recv_request_t *ptr)
 {
     ptr->cancel = false;
@@ -52,13 +52,35 @@
 #include "src/mca/rml/base/rml_contact.h"
 
 
-static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all);
+static void msg_match_recv(prte_rml_tag_bucket_t *bucket,
+                           prte_rml_posted_recv_t *rcv, bool get_all);
+
+/* lookup the bucket holding the posted recvs and unmatched
+ * msgs for the given tag, creating it if requested */
+static prte_rml_tag_bucket_t* get_bucket(prte_rml_tag_t tag, bool create)
+{
+    prte_rml_tag_bucket_t *bucket = NULL;
+
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint32(&prte_rml_base.tags, tag,
+                                                         (void**)&bucket) &&
+        NULL != bucket) {
+        return bucket;
+    }
+    if (!create) {
+        return NULL;
+    }
+    bucket = PRTE_NEW(prte_rml_tag_bucket_t);
+    bucket->tag = tag;
+    prte_hash_table_set_value_uint32(&prte_rml_base.tags, tag, bucket);
+    return bucket;
+}
 
 
 void prte_rml_base_post_recv(int sd, short args, void *cbdata)
 {
     prte_rml_recv_request_t *req = (prte_rml_recv_request_t*)cbdata;
     prte_rml_posted_recv_t *post, *recv;
+    prte_rml_tag_bucket_t *bucket;
     prte_ns_cmp_bitmask_t mask = PRTE_NS_CMP_ALL | PRTE_NS_CMP_WILD;
 
     PRTE_ACQUIRE_OBJECT(req);
@@ -80,7 +102,11 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
      * and remove it from our list
      */
     if (req->cancel) {
-        PRTE_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t) {
+        if (NULL == (bucket = get_bucket(post->tag, false))) {
+            PRTE_RELEASE(req);
+            return;
+        }
+        PRTE_LIST_FOREACH(recv, &bucket->posted_recvs, prte_rml_posted_recv_t) {
             if (PRTE_EQUAL == prte_util_compare_name_fields(mask, &post->peer, &recv->peer) &&
                 post->tag == recv->tag) {
                 prte_output_verbose(5, prte_rml_base_framework.framework_output,
@@ -88,7 +114,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                     post->tag, PRTE_NAME_PRINT(&recv->peer));
                 /* got a match - remove it */
-                prte_list_remove_item(&prte_rml_base.posted_recvs, &recv->super);
+                prte_list_remove_item(&bucket->posted_recvs, &recv->super);
                 PRTE_RELEASE(recv);
                 break;
             }
@@ -97,8 +123,11 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
         return;
     }
 
+    /* only recvs posted on this tag can conflict */
+    bucket = get_bucket(post->tag, true);
+
     /* bozo check - cannot have two receives for the same peer/tag combination */
-    PRTE_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t) {
+    PRTE_LIST_FOREACH(recv, &bucket->posted_recvs, prte_rml_posted_recv_t) {
         if (PRTE_EQUAL == prte_util_compare_name_fields(mask, &post->peer, &recv->peer) &&
             post->tag == recv->tag) {
             prte_output(0, "%s TWO RECEIVES WITH SAME PEER %s AND TAG %d - ABORTING",
@@ -114,27 +143,28 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
                         (post->persistent) ? "persistent" : "non-persistent",
                         post->tag, PRTE_NAME_PRINT(&post->peer));
     /* add it to the list of recvs */
-    prte_list_append(&prte_rml_base.posted_recvs, &post->super);
+    prte_list_append(&bucket->posted_recvs, &post->super);
     req->post = NULL;
     /* handle any messages that may have already arrived for this recv */
-    msg_match_recv(post, post->persistent);
+    msg_match_recv(bucket, post, post->persistent);
 
     /* cleanup */
     PRTE_RELEASE(req);
 }
 
-static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
+static void msg_match_recv(prte_rml_tag_bucket_t *bucket,
+                           prte_rml_posted_recv_t *rcv, bool get_all)
 {
     prte_list_item_t *item, *next;
     prte_rml_recv_t *msg;
     prte_ns_cmp_bitmask_t mask = PRTE_NS_CMP_ALL | PRTE_NS_CMP_WILD;
 
-    /* scan thru the list of unmatched recvd messages and
-     * see if any matches this spec - if so, push the first
+    /* scan thru the list of unmatched recvd messages for this
+     * tag and see if any matches this spec - if so, push the first
      * into the recvd msg queue and look no further
      */
-    item = prte_list_get_first(&prte_rml_base.unmatched_msgs);
-    while (item != prte_list_get_end(&prte_rml_base.unmatched_msgs)) {
+    item = prte_list_get_first(&bucket->unmatched_msgs);
+    while (item != prte_list_get_end(&bucket->unmatched_msgs)) {
         next = prte_list_get_next(item);
         msg = (prte_rml_recv_t*)item;
         prte_output_verbose(5, prte_rml_base_framework.framework_output,
@@ -146,10 +176,9 @@ static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
-        if (PRTE_EQUAL == prte_util_compare_name_fields(mask, &msg->sender, &rcv->peer) &&
-            msg->tag == rcv->tag) {
+        if (PRTE_EQUAL == prte_util_compare_name_fields(mask, &msg->sender, &rcv->peer)) {
+            prte_list_remove_item(&bucket->unmatched_msgs, item);
             PRTE_RML_ACTIVATE_MESSAGE(msg);
-            prte_list_remove_item(&prte_rml_base.unmatched_msgs, item);
             if (!get_all) {
                 break;
             }
@@ -162,6 +191,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
 {
     prte_rml_recv_t *msg = (prte_rml_recv_t*)cbdata;
     prte_rml_posted_recv_t *post;
+    prte_rml_tag_bucket_t *bucket;
     prte_ns_cmp_bitmask_t mask = PRTE_NS_CMP_ALL | PRTE_NS_CMP_WILD;
     prte_buffer_t buf;
 
@@ -201,18 +231,21 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
         }
     }
 
-    /* see if we have a waiting recv for this message */
-    PRTE_LIST_FOREACH(post, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t) {
+    /* see if we have a waiting recv for this message - only
+     * recvs posted on this tag need to be checked */
+    bucket = get_bucket(msg->tag, true);
+    PRTE_LIST_FOREACH(post, &bucket->posted_recvs, prte_rml_posted_recv_t) {
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
-        if (PRTE_EQUAL == prte_util_compare_name_fields(mask, &msg->sender, &post->peer) &&
-            msg->tag == post->tag) {
+        if (PRTE_EQUAL == prte_util_compare_name_fields(mask, &msg->sender, &post->peer)) {
             /* deliver the data to this location */
             if (post->buffer_data) {
                 /* deliver it in a buffer */
                 PRTE_CONSTRUCT(&buf, prte_buffer_t);
                 prte_dss.load(&buf, msg->iov.iov_base, msg->iov.iov_len);
+                /* skip anything the poster already consumed */
+                buf.unpack_ptr += msg->offset;
                 /* xfer ownership of the malloc'd data to the buffer */
                 msg->iov.iov_base = NULL;
                 post->cbfunc.buffer(PRTE_SUCCESS, &msg->sender, &buf, msg->tag, post->cbdata);
@@ -226,7 +259,15 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
                                      msg->tag));
                 PRTE_DESTRUCT(&buf);
             } else {
-                /* deliver as an iovec */
+                /* deliver as an iovec - the recipient may take
+                 * ownership of the data, so it has to start at
+                 * the front of the allocation */
+                if (0 < msg->offset) {
+                    msg->iov.iov_len -= msg->offset;
+                    memmove(msg->iov.iov_base, (char*)msg->iov.iov_base + msg->offset,
+                            msg->iov.iov_len);
+                    msg->offset = 0;
+                }
                 post->cbfunc.iov(PRTE_SUCCESS, &msg->sender, &msg->iov, 1, msg->tag, post->cbdata);
                 /* the user should have shifted the data to
                  * a local variable and NULL'd the iov_base
@@ -241,7 +282,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
                                  post->tag));
             /* if the recv is non-persistent, remove it */
             if (!post->persistent) {
-                prte_list_remove_item(&prte_rml_base.posted_recvs, &post->super);
+                prte_list_remove_item(&bucket->posted_recvs, &post->super);
                 /*PRTE_OUTPUT_VERBOSE((5, prte_rml_base_framework.framework_output,
                                      "%s non persistent recv %p remove success releasing now",
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -260,5 +301,5 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             PRTE_NAME_PRINT(&msg->sender),
                             msg->tag));
-     prte_list_append(&prte_rml_base.unmatched_msgs, &msg->super);
+     prte_list_append(&bucket->unmatched_msgs, &msg->super);
 }
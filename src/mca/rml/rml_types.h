@@ -195,6 +195,12 @@ BEGIN_C_DECLS
 /* error propagate  */
 #define PRTE_RML_TAG_PROPAGATE              71
 
+/* chunk of a segmented xcast */
+#define PRTE_RML_TAG_XCAST_CHUNK            72
+
+/* environment template for launch deltas */
+#define PRTE_RML_TAG_ENV_TEMPLATE           73
+
 #define PRTE_RML_TAG_MAX                   100
 
 
@@ -265,7 +265,7 @@ static void set(prte_job_t *jobdat,
     prte_app_context_t *context;
     int rc=PRTE_ERROR;
     char *msg;
-    char *cpu_bitmap;
+    const char *cpu_bitmap;
 
     prte_output_verbose(2, prte_rtc_base_framework.framework_output,
                         "%s hwloc:set on child %s",
@@ -285,9 +285,8 @@ static void set(prte_job_t *jobdat,
     context = (prte_app_context_t*)prte_pointer_array_get_item(jobdat->apps, child->app_idx);
 
     /* Set process affinity, if given */
-    cpu_bitmap = NULL;
-    if (!prte_get_attribute(&child->attributes, PRTE_PROC_CPU_BITMAP, (void**)&cpu_bitmap, PRTE_STRING) ||
-        NULL == cpu_bitmap || 0 == strlen(cpu_bitmap)) {
+    cpu_bitmap = (const char*)prte_get_attribute_ptr(&child->attributes, PRTE_PROC_CPU_BITMAP, PRTE_STRING);
+    if (NULL == cpu_bitmap || 0 == strlen(cpu_bitmap)) {
         /* if the daemon is bound, then we need to "free" this proc */
         if (NULL != prte_daemon_cores) {
             root = hwloc_get_root_obj(prte_hwloc_topology);
@@ -358,7 +357,6 @@ static void set(prte_job_t *jobdat,
                                                   "help-prte-odls-default.txt", "not bound",
                                                   prte_process_info.nodename, context->app, msg,
                                                   __FILE__, __LINE__);
-                free(cpu_bitmap);
                 return;
             }
         }
@@ -449,14 +447,10 @@ static void set(prte_job_t *jobdat,
                                                   "help-prte-odls-default.txt", "memory not bound",
                                                   prte_process_info.nodename, context->app, msg,
                                                   __FILE__, __LINE__);
-                free(cpu_bitmap);
                 return;
             }
         }
     }
-    if (NULL != cpu_bitmap) {
-        free(cpu_bitmap);
-    }
 }
 
 #if HWLOC_API_VERSION >= 0x20000
@@ -380,6 +380,9 @@ static void vm_ready(int fd, short args, void *cbdata)
             }
             PRTE_RELEASE(buf);
         }
+        /* the daemons now have the current map, so subsequent
+         * updates need only contain the changes */
+        prte_util_nidmap_clear_log();
         /* notify that the vm is ready */
         if (0 > prte_state_base_parent_fd) {
             if (prte_state_base_ready_msg && prte_persistent) {
@@ -406,6 +409,12 @@ static void vm_ready(int fd, short args, void *cbdata)
         return;
     }
 
+    /* if the node pool changed while preparing this job (e.g., nodes
+     * were added and daemons launched on them), let the daemons know */
+    if (PRTE_SUCCESS != (rc = prte_util_nidmap_send_update())) {
+        PRTE_ERROR_LOG(rc);
+    }
+
     /* position any required files */
     if (PRTE_SUCCESS != prte_filem.preposition_files(caddy->jdata, files_ready, caddy->jdata)) {
         PRTE_FORCED_TERMINATE(PRTE_ERROR_DEFAULT_EXIT_CODE);
@@ -439,6 +439,11 @@ typedef struct {
 
 #define PRTE_PMIX_SHOW_HELP    "prte.show.help"
 
+/* query keys for the collective trackers on the daemon
+ * answering the query */
+#define PRTE_PMIX_QUERY_NUM_COLL_TRACKERS   "prte.coll.ntrackers"   // (size_t) number of ongoing collectives
+#define PRTE_PMIX_QUERY_COLL_LOOKUP_TIME    "prte.coll.lookup.time" // (double) mean tracker lookup time in usec
+
 /* some helper functions */
 PRTE_EXPORT pmix_proc_state_t prte_pmix_convert_state(int state);
 PRTE_EXPORT int prte_pmix_convert_pstate(pmix_proc_state_t);
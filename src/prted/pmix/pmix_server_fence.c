@@ -42,6 +42,7 @@
 #include "src/threads/threads.h"
 #include "src/runtime/prte_globals.h"
 #include "src/mca/grpcomm/grpcomm.h"
+#include "src/mca/grpcomm/base/base.h"
 #include "src/mca/rml/rml.h"
 
 #include "src/prted/pmix/pmix_server_internal.h"
@@ -122,7 +123,9 @@ pmix_status_t pmix_server_fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
 
     /* pass it to the global collective algorithm */
     /* pass along any data that was collected locally */
-    if (PRTE_SUCCESS != (rc = prte_grpcomm.allgather(cd->sig, buf, 0, pmix_server_release, cd))) {
+    if (PRTE_SUCCESS != (rc = prte_grpcomm.allgather(cd->sig, buf,
+                                                     prte_grpcomm_base.fence_dedup ? PRTE_GRPCOMM_MODE_DEDUP : 0,
+                                                     pmix_server_release, cd))) {
         PRTE_ERROR_LOG(rc);
         PRTE_RELEASE(buf);
         return PMIX_ERROR;
@@ -46,6 +46,7 @@
 #include "src/mca/state/state.h"
 #include "src/util/name_fns.h"
 #include "src/util/show_help.h"
+#include "src/util/nidmap.h"
 #include "src/threads/threads.h"
 #include "src/runtime/prte_globals.h"
 #include "src/mca/rml/rml.h"
@@ -805,7 +806,9 @@ void prte_pmix_server_tool_conn_complete(prte_job_t *jdata,
             node = PRTE_NEW(prte_node_t);
             node->name = strdup(req->operation);
             PRTE_FLAG_SET(node, PRTE_NODE_NON_USABLE);
-            prte_pointer_array_add(prte_node_pool, node);
+            node->index = prte_pointer_array_add(prte_node_pool, node);
+            prte_node_index_add(node);
+            prte_util_nidmap_record(node, PRTE_NIDMAP_ADD);
         }
     }
     if (NULL == node) {
@@ -39,6 +39,7 @@
 #include "src/mca/pstat/pstat.h"
 
 #include "src/mca/errmgr/errmgr.h"
+#include "src/mca/grpcomm/base/base.h"
 #include "src/mca/iof/iof.h"
 #include "src/mca/rmaps/rmaps_types.h"
 #include "src/mca/schizo/schizo.h"
@@ -520,6 +521,18 @@ static void _query(int sd, short args, void *cbdata)
                 key = jdata->num_procs;
                 PMIX_INFO_LOAD(&kv->info, PMIX_JOB_SIZE, &key, PMIX_UINT32);
                 prte_list_append(&results, &kv->super);
+            } else if (0 == strcmp(q->keys[n], PRTE_PMIX_QUERY_NUM_COLL_TRACKERS) ||
+                       0 == strcmp(q->keys[n], PRTE_PMIX_QUERY_COLL_LOOKUP_TIME)) {
+                size_t ntrackers;
+                double lookup;
+                prte_grpcomm_base_tracker_stats(&ntrackers, &lookup);
+                kv = PRTE_NEW(prte_info_item_t);
+                if (0 == strcmp(q->keys[n], PRTE_PMIX_QUERY_NUM_COLL_TRACKERS)) {
+                    PMIX_INFO_LOAD(&kv->info, PRTE_PMIX_QUERY_NUM_COLL_TRACKERS, &ntrackers, PMIX_SIZE);
+                } else {
+                    PMIX_INFO_LOAD(&kv->info, PRTE_PMIX_QUERY_COLL_LOOKUP_TIME, &lookup, PMIX_DOUBLE);
+                }
+                prte_list_append(&results, &kv->super);
             } else {
                 fprintf(stderr, "Query for unrecognized attribute: %s\n", q->keys[n]);
             }
@@ -257,6 +257,19 @@ void prte_daemon_recv(int status, prte_process_name_t* sender,
         }
         break;
 
+    case PRTE_DAEMON_NIDMAP_UPDATE_CMD:
+        if (prte_debug_daemons_flag) {
+            prte_output(0, "%s prted_cmd: received nidmap update",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        }
+        if (!PRTE_PROC_IS_MASTER) {
+            if (PRTE_SUCCESS != (ret = prte_util_decode_nidmap(buffer))) {
+                PRTE_ERROR_LOG(ret);
+                goto CLEANUP;
+            }
+        }
+        break;
+
     case PRTE_DAEMON_PASS_NODE_INFO_CMD:
         if (prte_debug_daemons_flag) {
             prte_output(0, "%s prted_cmd: received pass_node_info",
@@ -894,6 +907,9 @@ static char *get_prted_comm_cmd_str(int command)
     case PRTE_DAEMON_PASS_NODE_INFO_CMD:
         return strdup("PRTE_DAEMON_PASS_NODE_INFO_CMD");
 
+    case PRTE_DAEMON_NIDMAP_UPDATE_CMD:
+        return strdup("PRTE_DAEMON_NIDMAP_UPDATE_CMD");
+
     default:
         return strdup("Unknown Command!");
     }
@@ -110,6 +110,13 @@ int prte_finalize(void)
 }
     PRTE_RELEASE(prte_node_topologies);
 
+    /* no need to maintain the node index while we tear down the pool */
+    PRTE_RELEASE(prte_node_index);
+    prte_node_index = NULL;
+
+    /* drop any outstanding proc reservation */
+    prte_proc_slab_retire();
+
 {
     prte_pointer_array_t * array = prte_node_pool;
     int i;
@@ -41,6 +41,7 @@
 #include "src/class/prte_value_array.h"
 #include "src/dss/dss.h"
 #include "src/threads/threads.h"
+#include "src/sys/atomic.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/rml/rml.h"
@@ -98,6 +99,8 @@ bool prte_allocation_required = false;
 bool prte_managed_allocation = false;
 char *prte_set_slots = NULL;
 bool prte_nidmap_communicated = false;
+int prte_nidmap_snapshot_interval = 16;
+bool prte_wait_use_pidfd = false;
 bool prte_node_info_communicated = false;
 
 /* launch agents */
@@ -123,6 +126,7 @@ int prte_stack_trace_wait_timeout = 30;
 /* global arrays for data storage */
 prte_hash_table_t *prte_job_data = NULL;
 prte_pointer_array_t *prte_node_pool = NULL;
+prte_hash_table_t *prte_node_index = NULL;
 prte_pointer_array_t *prte_node_topologies = NULL;
 prte_pointer_array_t *prte_local_children = NULL;
 prte_vpid_t prte_total_procs = 0;
@@ -453,19 +457,32 @@ prte_node_rank_t prte_get_proc_node_rank(prte_process_name_t *proc)
 
 bool prte_node_match(prte_node_t *n1, char *name)
 {
-    char **n2names = NULL;
-    char *n2alias = NULL;
     char **n1names = NULL;
     char *n1alias = NULL;
-    int i, m;
     prte_node_t *nptr;
+    bool match = false;
+    int i;
 
     /* start with the simple check */
     if (0 == strcmp(n1->name, name)) {
         return true;
     }
 
-    /* get the aliases for n1 and check those against "name" */
+    /* "name" might be the name or an alias of a node in the pool,
+     * in which case it matches if that node is also the one known
+     * by n1's name */
+    if (NULL != (nptr = prte_node_lookup(name))) {
+        if (nptr == n1 || nptr == prte_node_lookup(n1->name)) {
+            return true;
+        }
+    }
+
+    /* if n1 is in the pool, then its aliases are in the index */
+    if (0 <= n1->index && n1 == prte_pointer_array_get_item(prte_node_pool, n1->index)) {
+        return false;
+    }
+
+    /* otherwise, check its aliases against "name" */
     if (prte_get_attribute(&n1->attributes, PRTE_NODE_ALIAS, (void**)&n1alias, PRTE_STRING)) {
         n1names = prte_argv_split(n1alias, ',');
         free(n1alias);
@@ -473,63 +490,68 @@ bool prte_node_match(prte_node_t *n1, char *name)
     if (NULL != n1names) {
         for (i=0; NULL != n1names[i]; i++) {
             if (0 == strcmp(name, n1names[i])) {
-                prte_argv_free(n1names);
-                return true;
+                match = true;
+                break;
             }
         }
+        prte_argv_free(n1names);
     }
+    return match;
+}
 
-    /* "name" itself might be an alias, so find the node object for this name */
-    for (i=0; i < prte_node_pool->size; i++) {
-        if (NULL == (nptr = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
-            continue;
-        }
-        if (prte_get_attribute(&nptr->attributes, PRTE_NODE_ALIAS, (void**)&n2alias, PRTE_STRING)) {
-            n2names = prte_argv_split(n2alias, ',');
-            free(n2alias);
-        }
-        if (NULL == n2names) {
-            continue;
-        }
-        /* no choice but an exhaustive search - fortunately, these lists are short! */
-        for (m=0; NULL != n2names[m]; m++) {
-            if (0 == strcmp(name, n2names[m])) {
-                /* this is the node! */
-                goto complete;
-            }
-        }
-        prte_argv_free(n2names);
-        n2names = NULL;
-    }
-    return false;
-
-  complete:
-    /* only get here is we found the node for "name" */
-    if (NULL == n1names) {
-        for (m=0; NULL != n2names[m]; m++) {
-            if (0 == strcmp(n1->name, n2names[m])) {
-                prte_argv_free(n2names);
-                return true;
-            }
-        }
-    } else {
-        for (i=0; NULL != n1names[i]; i++) {
-            for (m=0; NULL != n2names[m]; m++) {
-                if (0 == strcmp(n1->name, n2names[m])) {
-                    prte_argv_free(n1names);
-                    prte_argv_free(n2names);
-                    return true;
-                }
+void prte_node_index_add(prte_node_t *node)
+{
+    char *alias = NULL, **aliases;
+    prte_node_t *nptr;
+    int i;
+
+    if (NULL == prte_node_index || NULL == node->name) {
+        return;
+    }
+    /* a node's name takes precedence over another node's alias, but
+     * keep the first node of a given name (e.g., when the allocation
+     * has been multiplied for testing) */
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(prte_node_index, node->name,
+                                                      strlen(node->name), (void**)&nptr) ||
+        0 != strcmp(nptr->name, node->name)) {
+        prte_hash_table_set_value_ptr(prte_node_index, node->name, strlen(node->name), node);
+    }
+    if (prte_get_attribute(&node->attributes, PRTE_NODE_ALIAS, (void**)&alias, PRTE_STRING)) {
+        aliases = prte_argv_split(alias, ',');
+        free(alias);
+        for (i=0; NULL != aliases && NULL != aliases[i]; i++) {
+            if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(prte_node_index, aliases[i],
+                                                              strlen(aliases[i]), (void**)&nptr)) {
+                prte_hash_table_set_value_ptr(prte_node_index, aliases[i], strlen(aliases[i]), node);
             }
         }
+        prte_argv_free(aliases);
     }
-    if (NULL != n1names) {
-        prte_argv_free(n1names);
+}
+
+static void node_index_remove(const char *name, prte_node_t *node)
+{
+    prte_node_t *nptr;
+
+    if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(prte_node_index, name,
+                                                      strlen(name), (void**)&nptr) &&
+        nptr == node) {
+        prte_hash_table_remove_value_ptr(prte_node_index, name, strlen(name));
+    }
+}
+
+prte_node_t* prte_node_lookup(const char *name)
+{
+    prte_node_t *nptr;
+
+    if (NULL == prte_node_index || NULL == name) {
+        return NULL;
     }
-    if (NULL != n2names) {
-        prte_argv_free(n2names);
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(prte_node_index, name,
+                                                      strlen(name), (void**)&nptr)) {
+        return NULL;
     }
-    return false;
+    return nptr;
 }
 
 /*
@@ -748,6 +770,20 @@ static void prte_node_destruct(prte_node_t* node)
 {
     int i;
     prte_proc_t *proc;
+    char *alias = NULL, **aliases;
+
+    if (NULL != prte_node_index && NULL != node->name) {
+        /* remove the node from the global index */
+        node_index_remove(node->name, node);
+        if (prte_get_attribute(&node->attributes, PRTE_NODE_ALIAS, (void**)&alias, PRTE_STRING)) {
+            aliases = prte_argv_split(alias, ',');
+            free(alias);
+            for (i=0; NULL != aliases && NULL != aliases[i]; i++) {
+                node_index_remove(aliases[i], node);
+            }
+            prte_argv_free(aliases);
+        }
+    }
 
     if (NULL != node->name) {
         free(node->name);
@@ -817,10 +853,139 @@ static void prte_proc_destruct(prte_proc_t* proc)
     PRTE_LIST_DESTRUCT(&proc->attributes);
 }
 
-PRTE_CLASS_INSTANCE(prte_proc_t,
-                   prte_list_item_t,
-                   prte_proc_construct,
-                   prte_proc_destruct);
+/* Large jobs create one proc object per rank on the HNP, so rather
+ * than malloc each of them individually the mapper reserves a slab
+ * sized for the job and the procs are carved out of it. Procs can be
+ * created by any thread, so the slabs are guarded by a lock - each
+ * slab counts the procs still alive in it plus one reference held
+ * while it is accepting allocations, and stays on the list of live
+ * slabs until the last of them has been released. Procs that were
+ * malloc'd on their own are recognized by not falling within any
+ * live slab, so they carry no extra header */
+typedef struct prte_proc_slab_t {
+    struct prte_proc_slab_t *next_slab;
+    int32_t refcount;
+    int32_t nobjs;
+    int32_t next;
+    size_t objsize;
+    char *base;
+} prte_proc_slab_t;
+
+#define PRTE_PROC_SLAB_MIN      256
+#define PRTE_PROC_SLAB_ALIGN(x) (((x) + 15) & ~((size_t)15))
+
+static prte_mutex_t proc_slab_lock = PRTE_MUTEX_STATIC_INIT;
+/* the slab currently accepting allocations */
+static prte_proc_slab_t *proc_slab = NULL;
+/* every slab that still has procs alive in it */
+static prte_proc_slab_t *proc_slabs = NULL;
+
+/* must be called with the lock held */
+static void proc_slab_release(prte_proc_slab_t *slab)
+{
+    prte_proc_slab_t **sp;
+
+    if (0 < --slab->refcount) {
+        return;
+    }
+    for (sp = &proc_slabs; NULL != *sp; sp = &(*sp)->next_slab) {
+        if (*sp == slab) {
+            *sp = slab->next_slab;
+            break;
+        }
+    }
+    free(slab);
+}
+
+/* must be called with the lock held */
+static void proc_slab_retire_locked(void)
+{
+    if (NULL != proc_slab) {
+        proc_slab_release(proc_slab);
+        proc_slab = NULL;
+    }
+}
+
+void prte_proc_slab_reserve(int32_t nprocs)
+{
+    prte_proc_slab_t *slab;
+    size_t objsize;
+
+    prte_mutex_lock(&proc_slab_lock);
+    proc_slab_retire_locked();
+    prte_mutex_unlock(&proc_slab_lock);
+    if (nprocs < PRTE_PROC_SLAB_MIN) {
+        return;
+    }
+    objsize = PRTE_PROC_SLAB_ALIGN(prte_proc_t_class.cls_sizeof);
+    slab = (prte_proc_slab_t*)malloc(PRTE_PROC_SLAB_ALIGN(sizeof(prte_proc_slab_t)) +
+                                     (size_t)nprocs * objsize);
+    if (NULL == slab) {
+        /* not fatal - we just fall back to individual allocations */
+        return;
+    }
+    slab->refcount = 1;
+    slab->nobjs = nprocs;
+    slab->next = 0;
+    slab->objsize = objsize;
+    slab->base = (char*)slab + PRTE_PROC_SLAB_ALIGN(sizeof(prte_proc_slab_t));
+    prte_mutex_lock(&proc_slab_lock);
+    slab->next_slab = proc_slabs;
+    proc_slabs = slab;
+    proc_slab = slab;
+    prte_mutex_unlock(&proc_slab_lock);
+}
+
+void prte_proc_slab_retire(void)
+{
+    prte_mutex_lock(&proc_slab_lock);
+    proc_slab_retire_locked();
+    prte_mutex_unlock(&proc_slab_lock);
+}
+
+static void *prte_proc_alloc(prte_class_t *cls)
+{
+    void *obj = NULL;
+
+    prte_mutex_lock(&proc_slab_lock);
+    if (NULL != proc_slab) {
+        obj = proc_slab->base + (size_t)proc_slab->next * proc_slab->objsize;
+        proc_slab->refcount++;
+        if (++proc_slab->next == proc_slab->nobjs) {
+            /* exhausted - let it go once its procs are gone */
+            proc_slab_retire_locked();
+        }
+    }
+    prte_mutex_unlock(&proc_slab_lock);
+    if (NULL == obj) {
+        obj = malloc(cls->cls_sizeof);
+    }
+    return obj;
+}
+
+static void prte_proc_free(prte_object_t *obj)
+{
+    prte_proc_slab_t *slab;
+    char *ptr = (char*)obj;
+
+    prte_mutex_lock(&proc_slab_lock);
+    for (slab = proc_slabs; NULL != slab; slab = slab->next_slab) {
+        if (slab->base <= ptr && ptr < slab->base + (size_t)slab->nobjs * slab->objsize) {
+            proc_slab_release(slab);
+            prte_mutex_unlock(&proc_slab_lock);
+            return;
+        }
+    }
+    prte_mutex_unlock(&proc_slab_lock);
+    free(obj);
+}
+
+PRTE_CLASS_INSTANCE_ALLOC(prte_proc_t,
+                          prte_list_item_t,
+                          prte_proc_construct,
+                          prte_proc_destruct,
+                          prte_proc_alloc,
+                          prte_proc_free);
 
 static void prte_job_map_construct(prte_job_map_t* map)
 {
@@ -832,6 +997,8 @@ static void prte_job_map_construct(prte_job_map_t* map)
     map->num_new_daemons = 0;
     map->daemon_vpid_start = PRTE_VPID_INVALID;
     map->num_nodes = 0;
+    map->ppn = NULL;
+    map->ppn_stride = 0;
     map->nodes = PRTE_NEW(prte_pointer_array_t);
     prte_pointer_array_init(map->nodes,
                             PRTE_GLOBAL_ARRAY_BLOCK_SIZE,
@@ -857,6 +1024,9 @@ static void prte_job_map_destruct(prte_job_map_t* map)
         }
     }
     PRTE_RELEASE(map->nodes);
+    if (NULL != map->ppn) {
+        free(map->ppn);
+    }
 }
 
 PRTE_CLASS_INSTANCE(prte_job_map_t,
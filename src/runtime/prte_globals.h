@@ -413,6 +413,13 @@ struct prte_proc_t {
 typedef struct prte_proc_t prte_proc_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_proc_t);
 
+/* reserve storage for the given number of proc objects so they
+ * can be created without individual allocations - retire the
+ * reservation when done creating the procs of a job. Requests too
+ * small to benefit are ignored */
+PRTE_EXPORT void prte_proc_slab_reserve(int32_t nprocs);
+PRTE_EXPORT void prte_proc_slab_retire(void);
+
 /**
  * Get a job data object
  * We cannot just reference a job data object with its jobid as
@@ -442,6 +449,13 @@ PRTE_EXPORT prte_node_rank_t prte_get_proc_node_rank(prte_process_name_t *proc);
 /* check to see if two nodes match */
 PRTE_EXPORT bool prte_node_match(prte_node_t *n1, char *name);
 
+/* index a node by its name and aliases - must be called again
+ * whenever the node's name or aliases change */
+PRTE_EXPORT void prte_node_index_add(prte_node_t *node);
+
+/* find the node known by the given name or alias */
+PRTE_EXPORT prte_node_t* prte_node_lookup(const char *name);
+
 /* global variables used by RTE - instanced in prte_globals.c */
 PRTE_EXPORT extern bool prte_debug_daemons_flag;
 PRTE_EXPORT extern bool prte_debug_daemons_file_flag;
@@ -483,6 +497,8 @@ PRTE_EXPORT extern bool prte_managed_allocation;
 PRTE_EXPORT extern char *prte_set_slots;
 PRTE_EXPORT extern bool prte_hnp_connected;
 PRTE_EXPORT extern bool prte_nidmap_communicated;
+PRTE_EXPORT extern int prte_nidmap_snapshot_interval;
+PRTE_EXPORT extern bool prte_wait_use_pidfd;
 PRTE_EXPORT extern bool prte_node_info_communicated;
 
 /* launch agents */
@@ -505,6 +521,7 @@ PRTE_EXPORT extern prte_timer_t *prte_mpiexec_timeout;
 /* global arrays for data storage */
 PRTE_EXPORT extern prte_hash_table_t *prte_job_data;
 PRTE_EXPORT extern prte_pointer_array_t *prte_node_pool;
+PRTE_EXPORT extern prte_hash_table_t *prte_node_index;
 PRTE_EXPORT extern prte_pointer_array_t *prte_node_topologies;
 PRTE_EXPORT extern prte_pointer_array_t *prte_local_children;
 PRTE_EXPORT extern prte_vpid_t prte_total_procs;
@@ -291,6 +291,12 @@ int prte_init(int* pargc, char*** pargv, prte_proc_type_t flags)
         error = "setup job array";
         goto error;
     }
+    prte_node_index = PRTE_NEW(prte_hash_table_t);
+    if (PRTE_SUCCESS != (ret = prte_hash_table_init(prte_node_index, 128))) {
+        PRTE_ERROR_LOG(ret);
+        error = "setup node index";
+        goto error;
+    }
     prte_node_pool = PRTE_NEW(prte_pointer_array_t);
     if (PRTE_SUCCESS != (ret = prte_pointer_array_init(prte_node_pool,
                                PRTE_GLOBAL_ARRAY_BLOCK_SIZE,
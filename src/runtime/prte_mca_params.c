@@ -640,6 +640,22 @@ int prte_register_params(void)
                                   PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                   &prte_max_vm_size);
 
+    prte_nidmap_snapshot_interval = 16;
+    (void) prte_mca_base_var_register ("prte", "prte", NULL, "nidmap_snapshot_interval",
+                                  "Number of incremental node map updates to send to the daemons between full snapshots "
+                                  "of the node map (0 => always send a full snapshot)",
+                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                  &prte_nidmap_snapshot_interval);
+
+    prte_wait_use_pidfd = false;
+    (void) prte_mca_base_var_register ("prte", "prte", NULL, "wait_use_pidfd",
+                                  "Watch each child process through its own pidfd instead of relying "
+                                  "solely on SIGCHLD (falls back to SIGCHLD where pidfds are not supported)",
+                                  PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                  &prte_wait_use_pidfd);
+
     (void) prte_mca_base_var_register ("prte", "prte", NULL, "set_default_slots",
                                   "Set the number of slots on nodes that lack such info to the"
                                   " number of specified objects [a number, \"cores\" (default),"
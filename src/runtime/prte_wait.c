@@ -48,11 +48,15 @@
 #ifdef HAVE_SYS_WAIT_H
 #include <sys/wait.h>
 #endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 #include "src/dss/dss_types.h"
 #include "src/class/prte_object.h"
 #include "src/util/output.h"
 #include "src/class/prte_list.h"
+#include "src/class/prte_hash_table.h"
 #include "src/event/event-internal.h"
 #include "src/threads/mutex.h"
 #include "src/sys/atomic.h"
@@ -86,9 +90,14 @@ static void wccon(prte_wait_tracker_t *p)
     p->child = NULL;
     p->cbfunc = NULL;
     p->cbdata = NULL;
+    p->pidfd = -1;
 }
 static void wcdes(prte_wait_tracker_t *p)
 {
+    if (0 <= p->pidfd) {
+        prte_event_del(&p->pidev);
+        close(p->pidfd);
+    }
     if (NULL != p->child) {
         PRTE_RELEASE(p->child);
     }
@@ -99,10 +108,15 @@ PRTE_CLASS_INSTANCE(prte_wait_tracker_t,
 
 /* Local Variables */
 static prte_event_t handler;
-static prte_list_t pending_cbs;
+/* trackers for the children we are waiting on, indexed by pid so
+ * that a mass exit of local procs can be processed in linear time */
+static prte_hash_table_t pending_cbs;
+/* set if the kernel turns out not to support pidfds */
+static bool pidfd_unsupported = false;
 
 /* Local Function Prototypes */
 static void wait_signal_callback(int fd, short event, void *arg);
+static void wait_pidfd_callback(int fd, short event, void *arg);
 
 /* Interface Functions */
 
@@ -118,8 +132,11 @@ void prte_wait_enable(void)
 
 int prte_wait_init(void)
 {
-    PRTE_CONSTRUCT(&pending_cbs, prte_list_t);
+    PRTE_CONSTRUCT(&pending_cbs, prte_hash_table_t);
+    prte_hash_table_init(&pending_cbs, 256);
 
+    /* SIGCHLD remains the fallback even when pidfds are in use - it
+     * catches any children that were not registered with us */
     prte_event_set(prte_event_base,
                    &handler, SIGCHLD, PRTE_EV_SIGNAL|PRTE_EV_PERSIST,
                    wait_signal_callback,
@@ -133,14 +150,71 @@ int prte_wait_init(void)
 
 int prte_wait_finalize(void)
 {
+    uint32_t key;
+    void *node, *nxt;
+    prte_wait_tracker_t *t2;
+    int rc;
+
     prte_event_del(&handler);
 
     /* clear out the pending cbs */
-    PRTE_LIST_DESTRUCT(&pending_cbs);
+    rc = prte_hash_table_get_first_key_uint32(&pending_cbs, &key, (void**)&t2, &node);
+    while (PRTE_SUCCESS == rc) {
+        PRTE_RELEASE(t2);
+        rc = prte_hash_table_get_next_key_uint32(&pending_cbs, &key, (void**)&t2, node, &nxt);
+        node = nxt;
+    }
+    PRTE_DESTRUCT(&pending_cbs);
 
     return PRTE_SUCCESS;
 }
 
+/* open a pidfd for the child and have the event library tell us
+ * when it becomes readable - i.e., when the child has exited */
+static void watch_pidfd(prte_wait_tracker_t *t2)
+{
+#ifdef SYS_pidfd_open
+    int fd;
+
+    if (!prte_wait_use_pidfd || pidfd_unsupported) {
+        return;
+    }
+    fd = syscall(SYS_pidfd_open, t2->child->pid, 0);
+    if (fd < 0) {
+        if (ENOSYS == errno) {
+            /* old kernel - just rely on SIGCHLD from now on */
+            pidfd_unsupported = true;
+        }
+        return;
+    }
+    t2->pidfd = fd;
+    prte_event_set(prte_event_base, &t2->pidev, fd,
+                   PRTE_EV_READ, wait_pidfd_callback, t2);
+    prte_event_set_priority(&t2->pidev, PRTE_SYS_PRI);
+    prte_event_add(&t2->pidev, NULL);
+#endif
+}
+
+/* the child has been reaped - record its status and fire the callback */
+static void complete(prte_wait_tracker_t *t2, int status)
+{
+    prte_hash_table_remove_value_uint32(&pending_cbs, (uint32_t)t2->child->pid);
+    if (0 <= t2->pidfd) {
+        prte_event_del(&t2->pidev);
+        close(t2->pidfd);
+        t2->pidfd = -1;
+    }
+    t2->child->exit_code = status;
+    if (NULL != t2->cbfunc) {
+        prte_event_set(t2->evb, &t2->ev, -1,
+                       PRTE_EV_WRITE, t2->cbfunc, t2);
+        prte_event_set_priority(&t2->ev, PRTE_MSG_PRI);
+        prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
+    } else {
+        PRTE_RELEASE(t2);
+    }
+}
+
 /* this function *must* always be called from
  * within an event in the prte_event_base */
 void prte_wait_cb(prte_proc_t *child, prte_wait_cbfunc_t callback,
@@ -173,12 +247,21 @@ void prte_wait_cb(prte_proc_t *child, prte_wait_cbfunc_t callback,
     }
 
    /* we just override any existing registration */
-    PRTE_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t) {
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint32(&pending_cbs, (uint32_t)child->pid, (void**)&t2)) {
         if (t2->child == child) {
             t2->cbfunc = callback;
             t2->cbdata = data;
             return;
         }
+        /* the pid was reused - the old tracker belongs to a
+         * child we will never hear from again */
+        prte_hash_table_remove_value_uint32(&pending_cbs, (uint32_t)child->pid);
+        if (0 <= t2->pidfd) {
+            prte_event_del(&t2->pidev);
+            close(t2->pidfd);
+            t2->pidfd = -1;
+        }
+        PRTE_RELEASE(t2);
     }
     /* get here if this is a new registration */
     t2 = PRTE_NEW(prte_wait_tracker_t);
@@ -187,7 +270,8 @@ void prte_wait_cb(prte_proc_t *child, prte_wait_cbfunc_t callback,
     t2->evb = evb;
     t2->cbfunc = callback;
     t2->cbdata = data;
-    prte_list_append(&pending_cbs, &t2->super);
+    prte_hash_table_set_value_uint32(&pending_cbs, (uint32_t)child->pid, t2);
+    watch_pidfd(t2);
 }
 
 static void cancel_callback(int fd, short args, void *cbdata)
@@ -197,13 +281,10 @@ static void cancel_callback(int fd, short args, void *cbdata)
 
     PRTE_ACQUIRE_OBJECT(trk);
 
-    PRTE_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t) {
-        if (t2->child == trk->child) {
-            prte_list_remove_item(&pending_cbs, &t2->super);
-            PRTE_RELEASE(t2);
-            PRTE_RELEASE(trk);
-            return;
-        }
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint32(&pending_cbs, (uint32_t)trk->child->pid, (void**)&t2) &&
+        t2->child == trk->child) {
+        prte_hash_table_remove_value_uint32(&pending_cbs, (uint32_t)trk->child->pid);
+        PRTE_RELEASE(t2);
     }
 
     PRTE_RELEASE(trk);
@@ -255,22 +336,29 @@ static void wait_signal_callback(int fd, short event, void *arg)
             return;
         }
 
-        /* we are already in an event, so it is safe to access the list */
-        PRTE_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t) {
-            if (pid == t2->child->pid) {
-                /* found it! */
-                t2->child->exit_code = status;
-                prte_list_remove_item(&pending_cbs, &t2->super);
-                if (NULL != t2->cbfunc) {
-                    prte_event_set(t2->evb, &t2->ev, -1,
-                                   PRTE_EV_WRITE, t2->cbfunc, t2);
-                    prte_event_set_priority(&t2->ev, PRTE_MSG_PRI);
-                    prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
-                } else {
-                    PRTE_RELEASE(t2);
-                }
-                break;
-            }
+        /* we are already in an event, so it is safe to access the table */
+        if (PRTE_SUCCESS == prte_hash_table_get_value_uint32(&pending_cbs, (uint32_t)pid, (void**)&t2)) {
+            complete(t2, status);
         }
     }
 }
+
+/* callback from the event library when a child's pidfd becomes readable */
+static void wait_pidfd_callback(int fd, short event, void *arg)
+{
+    prte_wait_tracker_t *t2 = (prte_wait_tracker_t*)arg;
+    int status;
+    pid_t pid;
+
+    PRTE_ACQUIRE_OBJECT(t2);
+
+    do {
+        pid = waitpid(t2->child->pid, &status, WNOHANG);
+    } while (-1 == pid && EINTR == errno);
+
+    if (pid == t2->child->pid) {
+        complete(t2, status);
+    }
+    /* otherwise the SIGCHLD handler already reaped it, or this was
+     * spurious - either way there is nothing more to do here */
+}
@@ -66,6 +66,9 @@ typedef struct {
     prte_proc_t *child;
     prte_wait_cbfunc_t cbfunc;
     void *cbdata;
+    /* pidfd watching the child, or -1 */
+    int pidfd;
+    prte_event_t pidev;
 } prte_wait_tracker_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_wait_tracker_t);
 
@@ -62,6 +62,32 @@ bool prte_get_attribute(prte_list_t *attributes,
     return false;
 }
 
+const void* prte_get_attribute_ptr(prte_list_t *attributes,
+                                   prte_attribute_key_t key,
+                                   prte_data_type_t type)
+{
+    prte_attribute_t *kv;
+
+    PRTE_LIST_FOREACH(kv, attributes, prte_attribute_t) {
+        if (key == kv->key) {
+            if (kv->type != type) {
+                PRTE_ERROR_LOG(PRTE_ERR_TYPE_MISMATCH);
+                return NULL;
+            }
+            switch (type) {
+            case PRTE_STRING:
+                return kv->data.string;
+            case PRTE_PTR:
+                return kv->data.ptr;
+            default:
+                return &kv->data;
+            }
+        }
+    }
+    /* not found */
+    return NULL;
+}
+
 int prte_set_attribute(prte_list_t *attributes,
                        prte_attribute_key_t key, bool local,
                        void *data, prte_data_type_t type)
@@ -254,6 +254,17 @@ PRTE_EXPORT const char *prte_attr_key_to_str(prte_attribute_key_t key);
 PRTE_EXPORT bool prte_get_attribute(prte_list_t *attributes, prte_attribute_key_t key,
                                       void **data, prte_data_type_t type);
 
+/* Retrieve the named attribute from a list without copying it. Returns
+ * NULL if the attribute isn't present. Otherwise, returns the stored
+ * string for PRTE_STRING, the stored pointer for PRTE_PTR, and a pointer
+ * to the stored value for all other types. The result belongs to the
+ * list and is only valid until the attribute is changed or removed.
+ * Like prte_get_attribute, this walks the list - it only saves the
+ * copy (and the strdup for strings) on the way out */
+PRTE_EXPORT const void* prte_get_attribute_ptr(prte_list_t *attributes,
+                                               prte_attribute_key_t key,
+                                               prte_data_type_t type);
+
 /* Set the named attribute in a list, overwriting any prior entry */
 PRTE_EXPORT int prte_set_attribute(prte_list_t *attributes, prte_attribute_key_t key,
                                      bool local, void *data, prte_data_type_t type);
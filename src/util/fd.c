@@ -193,10 +193,25 @@ static int fdmax = -1;
    and the pipe up to the parent. */
 void prte_close_open_file_descriptors(int protected_fd)
 {
-    DIR *dir = opendir("/proc/self/fd");
+    DIR *dir;
     int fd;
     struct dirent *files;
 
+#if HAVE_CLOSE_RANGE
+    /* let the kernel do it - this avoids walking /proc/self/fd,
+     * which is expensive when the parent holds many sockets */
+    if (protected_fd < 3) {
+        if (0 == close_range(3, ~0U, 0)) {
+            return;
+        }
+    } else if ((3 == protected_fd || 0 == close_range(3, protected_fd - 1, 0)) &&
+               0 == close_range(protected_fd + 1, ~0U, 0)) {
+        return;
+    }
+    /* older kernel - fall back to the scan */
+#endif
+
+    dir = opendir("/proc/self/fd");
     if (NULL == dir) {
         goto slow;
     }
@@ -27,12 +27,380 @@
 #include "src/util/argv.h"
 
 #include "src/mca/errmgr/errmgr.h"
+#include "src/mca/grpcomm/grpcomm.h"
+#include "src/mca/odls/odls_types.h"
 #include "src/mca/rmaps/base/base.h"
+#include "src/mca/rml/rml_types.h"
 #include "src/mca/routed/routed.h"
 #include "src/runtime/prte_globals.h"
 
 #include "src/util/nidmap.h"
 
+/* type of nidmap being transmitted */
+#define PRTE_NIDMAP_FULL    0
+#define PRTE_NIDMAP_DELTA   1
+
+/* change to the node pool that has not yet been
+ * communicated to the daemons */
+typedef struct {
+    prte_list_item_t super;
+    uint8_t op;
+    int32_t index;
+} prte_nidmap_record_t;
+static PRTE_CLASS_INSTANCE(prte_nidmap_record_t,
+                           prte_list_item_t,
+                           NULL, NULL);
+
+/* the HNP advances the epoch each time the node pool changes - the
+ * daemons track the epoch of the last map they applied so they can
+ * tell if an update is based on what they have */
+static uint32_t nidmap_epoch = 0;
+static uint32_t nidmap_sent_epoch = 0;
+static int nidmap_nupdates = 0;
+static bool nidmap_log_init = false;
+static prte_list_t nidmap_log;
+
+static prte_topology_t* nidmap_topology(void)
+{
+    prte_topology_t *t;
+    int n;
+
+    for (n=0; n < prte_node_topologies->size; n++) {
+        if (NULL != (t = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, n))) {
+            return t;
+        }
+    }
+    return NULL;
+}
+
+static void nidmap_drop_node(int index)
+{
+    prte_node_t *nd;
+    prte_proc_t *proc;
+
+    if (NULL == (nd = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, index))) {
+        return;
+    }
+    prte_util_nidmap_record(nd, PRTE_NIDMAP_REMOVE);
+    prte_pointer_array_set_item(prte_node_pool, index, NULL);
+    if (NULL != (proc = nd->daemon)) {
+        nd->daemon = NULL;
+        if (proc->node == nd) {
+            proc->node = NULL;
+            PRTE_RELEASE(nd);
+        }
+        PRTE_RELEASE(proc);
+    }
+    PRTE_RELEASE(nd);
+}
+
+static prte_node_t* nidmap_set_node(prte_job_t *daemons, prte_topology_t *t,
+                                    int index, char *name, uint32_t vpid)
+{
+    prte_node_t *nd;
+    prte_proc_t *proc;
+    char *raw;
+
+    nd = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, index);
+    if (NULL != nd && 0 != strcmp(nd->name, name)) {
+        /* this slot now holds a different node */
+        nidmap_drop_node(index);
+        nd = NULL;
+    }
+    if (NULL == nd) {
+        /* add this name to the pool */
+        nd = PRTE_NEW(prte_node_t);
+        nd->name = strdup(name);
+        nd->index = index;
+        prte_pointer_array_set_item(prte_node_pool, index, nd);
+        /* see if this is our node */
+        if (prte_check_host_is_local(name)) {
+            /* add our aliases as an attribute - will include all the interface aliases captured in prte_init */
+            raw = prte_argv_join(prte_process_info.aliases, ',');
+            prte_set_attribute(&nd->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, raw, PRTE_STRING);
+            free(raw);
+        }
+        /* set the topology - always default to homogeneous
+         * as that is the most common scenario */
+        nd->topology = t;
+        prte_node_index_add(nd);
+    }
+    /* see if it has a daemon on it - a node's daemon
+     * never changes once it has been assigned */
+    if (UINT32_MAX != vpid && NULL == nd->daemon) {
+        if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(daemons->procs, vpid))) {
+            proc = PRTE_NEW(prte_proc_t);
+            proc->name.jobid = PRTE_PROC_MY_NAME->jobid;
+            proc->name.vpid = vpid;
+            proc->state = PRTE_PROC_STATE_RUNNING;
+            PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
+            daemons->num_procs++;
+            prte_pointer_array_set_item(daemons->procs, proc->name.vpid, proc);
+        }
+        PRTE_RETAIN(nd);
+        proc->node = nd;
+        PRTE_RETAIN(proc);
+        nd->daemon = proc;
+    }
+    return nd;
+}
+
+/* node names are commonly of the form <prefix><number><suffix>
+ * with consecutive numbers, so describe them as ranges when we
+ * can rather than shipping the full list */
+#define PRTE_NIDMAP_NAMES_LIST      0
+#define PRTE_NIDMAP_NAMES_RANGES    1
+
+/* width value for a name that contains no number */
+#define PRTE_NIDMAP_NO_NUMBER       UINT8_MAX
+
+typedef struct {
+    char *prefix;
+    char *suffix;
+    uint32_t start;
+    uint32_t count;
+    uint8_t width;      // zero-padded width of the number, or 0 if not padded
+} prte_nidmap_range_t;
+
+static void nidmap_free_ranges(prte_nidmap_range_t *ranges, int32_t nranges)
+{
+    int32_t n;
+
+    for (n=0; n < nranges; n++) {
+        if (NULL != ranges[n].prefix) {
+            free(ranges[n].prefix);
+        }
+        if (NULL != ranges[n].suffix) {
+            free(ranges[n].suffix);
+        }
+    }
+    free(ranges);
+}
+
+/* split a name around its last run of digits */
+static bool nidmap_split_name(const char *name, size_t *plen,
+                              const char **digits, size_t *dlen,
+                              uint32_t *num)
+{
+    const char *end, *start;
+
+    end = name + strlen(name);
+    while (end > name && !isdigit((unsigned char)end[-1])) {
+        --end;
+    }
+    if (end == name) {
+        return false;
+    }
+    start = end;
+    while (start > name && isdigit((unsigned char)start[-1])) {
+        --start;
+    }
+    /* keep the number within the range of a uint32 */
+    if (9 < end - start) {
+        return false;
+    }
+    *plen = start - name;
+    *digits = start;
+    *dlen = end - start;
+    *num = strtoul(start, NULL, 10);
+    return true;
+}
+
+static bool nidmap_in_range(prte_nidmap_range_t *r, const char *name)
+{
+    const char *digits;
+    size_t plen, dlen;
+    uint32_t num;
+    char tmp[16];
+
+    if (PRTE_NIDMAP_NO_NUMBER == r->width ||
+        !nidmap_split_name(name, &plen, &digits, &dlen, &num)) {
+        return false;
+    }
+    if (num != r->start + r->count ||
+        plen != strlen(r->prefix) ||
+        0 != strncmp(name, r->prefix, plen) ||
+        0 != strcmp(digits + dlen, r->suffix)) {
+        return false;
+    }
+    /* the number must print the same way as the rest of the range */
+    if (dlen != (size_t)snprintf(tmp, sizeof(tmp), "%0*u", (int)r->width, num) ||
+        0 != memcmp(tmp, digits, dlen)) {
+        return false;
+    }
+    return true;
+}
+
+static int nidmap_encode_ranges(char **names, int nnames,
+                                prte_buffer_t *buffer)
+{
+    prte_nidmap_range_t *ranges, *r = NULL;
+    int32_t n, nranges = 0, max;
+    const char *digits;
+    size_t plen, dlen;
+    uint32_t num;
+    uint8_t u8;
+    int rc = PRTE_SUCCESS;
+
+    if (0 == nnames) {
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    /* if the names don't collapse to a small number of ranges,
+     * then they are irregular and we are better off compressing
+     * the whole list */
+    max = nnames / 4 + 1;
+    ranges = (prte_nidmap_range_t*)calloc(max, sizeof(prte_nidmap_range_t));
+    if (NULL == ranges) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (n=0; n < nnames; n++) {
+        if (NULL != r && nidmap_in_range(r, names[n])) {
+            r->count++;
+            continue;
+        }
+        if (max == nranges) {
+            rc = PRTE_ERR_TAKE_NEXT_OPTION;
+            goto cleanup;
+        }
+        r = &ranges[nranges++];
+        r->count = 1;
+        if (nidmap_split_name(names[n], &plen, &digits, &dlen, &num)) {
+            r->prefix = strndup(names[n], plen);
+            r->suffix = strdup(digits + dlen);
+            r->start = num;
+            if (1 < dlen && '0' == digits[0]) {
+                r->width = dlen;
+            } else {
+                r->width = 0;
+            }
+        } else {
+            r->prefix = strdup(names[n]);
+            r->suffix = NULL;
+            r->start = 0;
+            r->width = PRTE_NIDMAP_NO_NUMBER;
+        }
+    }
+
+    u8 = PRTE_NIDMAP_NAMES_RANGES;
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &u8, 1, PRTE_UINT8))) {
+        PRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nranges, 1, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (n=0; n < nranges; n++) {
+        r = &ranges[n];
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &r->prefix, 1, PRTE_STRING))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &r->suffix, 1, PRTE_STRING))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &r->start, 1, PRTE_UINT32))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &r->count, 1, PRTE_UINT32))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &r->width, 1, PRTE_UINT8))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    }
+
+  cleanup:
+    nidmap_free_ranges(ranges, nranges);
+    return rc;
+}
+
+static int nidmap_decode_ranges(prte_buffer_t *buf,
+                                prte_nidmap_range_t **rptr,
+                                int32_t *nr)
+{
+    prte_nidmap_range_t *ranges, *r;
+    int32_t n, nranges;
+    int cnt, rc;
+
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &nranges, &cnt, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    ranges = (prte_nidmap_range_t*)calloc(nranges, sizeof(prte_nidmap_range_t));
+    if (NULL == ranges) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (n=0; n < nranges; n++) {
+        r = &ranges[n];
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &r->prefix, &cnt, PRTE_STRING))) {
+            break;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &r->suffix, &cnt, PRTE_STRING))) {
+            break;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &r->start, &cnt, PRTE_UINT32))) {
+            break;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &r->count, &cnt, PRTE_UINT32))) {
+            break;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &r->width, &cnt, PRTE_UINT8))) {
+            break;
+        }
+        /* empty strings are transmitted as NULL */
+        if (NULL == r->prefix) {
+            r->prefix = strdup("");
+        }
+        if (NULL == r->suffix) {
+            r->suffix = strdup("");
+        }
+    }
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        nidmap_free_ranges(ranges, nranges);
+        return rc;
+    }
+    *rptr = ranges;
+    *nr = nranges;
+    return PRTE_SUCCESS;
+}
+
+static inline uint32_t nidmap_vpid(int nbytes, uint8_t *vp8, uint16_t *vp16,
+                                   uint32_t *vp32, int n)
+{
+    if (1 == nbytes && UINT8_MAX != vp8[n]) {
+        return vp8[n];
+    } else if (2 == nbytes && UINT16_MAX != vp16[n]) {
+        return vp16[n];
+    } else if (4 == nbytes && UINT32_MAX != vp32[n]) {
+        return vp32[n];
+    }
+    return UINT32_MAX;
+}
+
+/* step over the slots that are empty in the HNP's pool */
+static int32_t nidmap_skip_holes(int32_t *holes, int32_t nholes,
+                                 int32_t *h, int32_t index)
+{
+    while (*h < nholes && holes[*h] == index) {
+        nidmap_drop_node(index);
+        ++index;
+        ++(*h);
+    }
+    return index;
+}
+
 int prte_util_nidmap_create(prte_pointer_array_t *pool,
                             prte_buffer_t *buffer)
 {
@@ -46,6 +414,18 @@ int prte_util_nidmap_create(prte_pointer_array_t *pool,
     prte_node_t *nptr;
     prte_byte_object_t bo, *boptr;
     size_t sz;
+    int32_t *holes, nholes, last;
+
+    /* indicate that this is a full snapshot of the map */
+    u8 = PRTE_NIDMAP_FULL;
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &u8, 1, PRTE_UINT8))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nidmap_epoch, 1, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
 
     /* pack a flag indicating if the HNP was included in the allocation */
     if (prte_hnp_is_allocated) {
@@ -69,6 +449,40 @@ int prte_util_nidmap_create(prte_pointer_array_t *pool,
         return rc;
     }
 
+    /* the nodes are sent without the empty slots between them, so
+     * pass the location of those slots to keep each node at the
+     * same index as on the HNP - later updates refer to it */
+    last = -1;
+    nholes = 0;
+    for (n=0; n < pool->size; n++) {
+        if (NULL != prte_pointer_array_get_item(pool, n)) {
+            nholes += n - last - 1;
+            last = n;
+        }
+    }
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nholes, 1, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 < nholes) {
+        holes = (int32_t*)malloc(nholes * sizeof(int32_t));
+        if (NULL == holes) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        nholes = 0;
+        for (n=0; n < last; n++) {
+            if (NULL == prte_pointer_array_get_item(pool, n)) {
+                holes[nholes++] = n;
+            }
+        }
+        rc = prte_dss.pack(buffer, holes, nholes, PRTE_INT32);
+        free(holes);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
     /* daemon vpids start from 0 and increase linearly by one
      * up to the number of nodes in the system. The vpid is
      * a 32-bit value. We don't know how many of the nodes
@@ -118,45 +532,57 @@ int prte_util_nidmap_create(prte_pointer_array_t *pool,
         ++ndaemons;
     }
 
-    /* construct the string of node names for compression */
-    raw = prte_argv_join(names, ',');
-    if (prte_compress.compress_block((uint8_t*)raw, strlen(raw)+1,
-                                     (uint8_t**)&bo.bytes, &sz)) {
-        /* mark that this was compressed */
-        compressed = true;
-        bo.size = sz;
-    } else {
-        /* mark that this was not compressed */
-        compressed = false;
-        bo.bytes = (uint8_t*)raw;
-        bo.size = strlen(raw)+1;
-    }
-    /* indicate compression */
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &compressed, 1, PRTE_BOOL))) {
+    /* describe the node names as ranges if we can */
+    rc = nidmap_encode_ranges(names, ndaemons, buffer);
+    if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+        /* too irregular - send the full list */
+        u8 = PRTE_NIDMAP_NAMES_LIST;
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &u8, 1, PRTE_UINT8))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        /* construct the string of node names for compression */
+        raw = prte_argv_join(names, ',');
+        if (prte_compress.compress_block((uint8_t*)raw, strlen(raw)+1,
+                                         (uint8_t**)&bo.bytes, &sz)) {
+            /* mark that this was compressed */
+            compressed = true;
+            bo.size = sz;
+        } else {
+            /* mark that this was not compressed */
+            compressed = false;
+            bo.bytes = (uint8_t*)raw;
+            bo.size = strlen(raw)+1;
+        }
+        /* indicate compression */
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &compressed, 1, PRTE_BOOL))) {
+            if (compressed) {
+                free(bo.bytes);
+            }
+            goto cleanup;
+        }
+        /* if compressed, provide the uncompressed size */
         if (compressed) {
-            free(bo.bytes);
+            sz = strlen(raw)+1;
+            if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &sz, 1, PRTE_SIZE))) {
+                free(bo.bytes);
+                goto cleanup;
+            }
         }
-        goto cleanup;
-    }
-    /* if compressed, provide the uncompressed size */
-    if (compressed) {
-        sz = strlen(raw)+1;
-        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &sz, 1, PRTE_SIZE))) {
-            free(bo.bytes);
+        /* add the object */
+        boptr = &bo;
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &boptr, 1, PRTE_BYTE_OBJECT))) {
+            if (compressed) {
+                free(bo.bytes);
+            }
             goto cleanup;
         }
-    }
-    /* add the object */
-    boptr = &bo;
-    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &boptr, 1, PRTE_BYTE_OBJECT))) {
         if (compressed) {
             free(bo.bytes);
         }
+    } else if (PRTE_SUCCESS != rc) {
         goto cleanup;
     }
-    if (compressed) {
-        free(bo.bytes);
-    }
 
     /* compress the vpids */
     if (prte_compress.compress_block(vpids, nbytes*ndaemons,
@@ -221,21 +647,211 @@ int prte_util_nidmap_create(prte_pointer_array_t *pool,
     return rc;
 }
 
+static int nidmap_create_delta(prte_buffer_t *buffer)
+{
+    prte_nidmap_record_t *rec;
+    prte_node_t *nd;
+    uint8_t u8;
+    uint32_t vpid;
+    int32_t nrecs;
+    int rc;
+
+    /* indicate that this is a delta, and the epoch it applies to */
+    u8 = PRTE_NIDMAP_DELTA;
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &u8, 1, PRTE_UINT8))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nidmap_sent_epoch, 1, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    /* and the epoch it brings them to */
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nidmap_epoch, 1, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    nrecs = prte_list_get_size(&nidmap_log);
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nrecs, 1, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    /* records are applied in order, and always carry the
+     * current info for the node */
+    PRTE_LIST_FOREACH(rec, &nidmap_log, prte_nidmap_record_t) {
+        nd = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, rec->index);
+        u8 = rec->op;
+        if (NULL == nd) {
+            /* the node has since been removed */
+            u8 = PRTE_NIDMAP_REMOVE;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &u8, 1, PRTE_UINT8))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &rec->index, 1, PRTE_INT32))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        if (PRTE_NIDMAP_REMOVE == u8) {
+            continue;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nd->name, 1, PRTE_STRING))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        if (NULL == nd->daemon) {
+            vpid = UINT32_MAX;
+        } else {
+            vpid = nd->daemon->name.vpid;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &vpid, 1, PRTE_UINT32))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        if (PRTE_SUCCESS != (rc = prte_dss.pack(buffer, &nd->state, 1, PRTE_NODE_STATE_T))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+static int decode_delta(prte_buffer_t *buf, uint32_t base)
+{
+    uint32_t epoch, vpid;
+    int32_t n, nrecs, index;
+    uint8_t op;
+    int cnt, rc;
+    char *name;
+    prte_node_state_t state;
+    prte_node_t *nd;
+    prte_job_t *daemons = NULL;
+    prte_topology_t *t = NULL;
+    bool apply = false;
+
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &epoch, &cnt, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &nrecs, &cnt, PRTE_INT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* a daemon started after these changes were made already
+     * has them in the snapshot it was given, while a daemon
+     * that missed an earlier update cannot apply this one and
+     * must wait for the next snapshot to resync */
+    if (!PRTE_PROC_IS_MASTER) {
+        if (epoch <= nidmap_epoch) {
+            PRTE_OUTPUT_VERBOSE((2, prte_debug_output,
+                                 "%s nidmap: already at epoch %u - ignoring update to %u",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nidmap_epoch, epoch));
+        } else if (base != nidmap_epoch) {
+            PRTE_OUTPUT_VERBOSE((2, prte_debug_output,
+                                 "%s nidmap: update based on epoch %u but have %u - awaiting snapshot",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), base, nidmap_epoch));
+        } else if (NULL == (t = nidmap_topology())) {
+            /* should never happen */
+            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        } else {
+            daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->jobid);
+            apply = true;
+        }
+    }
+
+    for (n=0; n < nrecs; n++) {
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &op, &cnt, PRTE_UINT8))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &index, &cnt, PRTE_INT32))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        if (PRTE_NIDMAP_REMOVE == op) {
+            if (apply) {
+                nidmap_drop_node(index);
+            }
+            continue;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &name, &cnt, PRTE_STRING))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &vpid, &cnt, PRTE_UINT32))) {
+            PRTE_ERROR_LOG(rc);
+            free(name);
+            return rc;
+        }
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &state, &cnt, PRTE_NODE_STATE_T))) {
+            PRTE_ERROR_LOG(rc);
+            free(name);
+            return rc;
+        }
+        if (apply) {
+            nd = nidmap_set_node(daemons, t, index, name, vpid);
+            nd->state = state;
+            if (PRTE_NODE_STATE_DOWN == state && NULL != nd->daemon) {
+                PRTE_FLAG_UNSET(nd->daemon, PRTE_PROC_FLAG_ALIVE);
+                nd->daemon->state = PRTE_PROC_STATE_COMM_FAILED;
+            }
+        }
+        free(name);
+    }
+
+    if (apply) {
+        nidmap_epoch = epoch;
+        /* update num procs */
+        if (prte_process_info.num_daemons != daemons->num_procs) {
+            prte_process_info.num_daemons = daemons->num_procs;
+        }
+        /* need to update the routing plan */
+        prte_routed.update_routing_plan();
+    }
+    return PRTE_SUCCESS;
+}
+
 int prte_util_decode_nidmap(prte_buffer_t *buf)
 {
     uint8_t u8, *vp8 = NULL;
     uint16_t *vp16 = NULL;
-    uint32_t *vp32 = NULL, vpid;
+    uint32_t *vp32 = NULL, vpid, epoch;
     int cnt, rc, nbytes, n;
     bool compressed;
     size_t sz;
     prte_byte_object_t *boptr;
     char *raw = NULL, **names = NULL;
-    prte_node_t *nd;
+    char host[PRTE_MAXHOSTNAMELEN];
+    prte_nidmap_range_t *ranges = NULL, *rng;
+    int32_t r, nranges = 0, *holes = NULL, nholes, h, index;
+    uint32_t k;
     prte_job_t *daemons;
-    prte_proc_t *proc;
     prte_topology_t *t = NULL;
 
+    /* unpack the type of map and its epoch */
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &u8, &cnt, PRTE_UINT8))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    cnt = 1;
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &epoch, &cnt, PRTE_UINT32))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (PRTE_NIDMAP_DELTA == u8) {
+        return decode_delta(buf, epoch);
+    }
+
     /* unpack the flag indicating if HNP is in allocation */
     cnt = 1;
     if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &u8, &cnt, PRTE_UINT8))) {
@@ -260,52 +876,83 @@ int prte_util_decode_nidmap(prte_buffer_t *buf)
         prte_managed_allocation = false;
     }
 
-    /* unpack compression flag for node names */
+    /* unpack the empty slots in the HNP's pool */
     cnt = 1;
-    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &compressed, &cnt, PRTE_BOOL))) {
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &nholes, &cnt, PRTE_INT32))) {
         PRTE_ERROR_LOG(rc);
         goto cleanup;
     }
-
-    /* if compressed, get the uncompressed size */
-    if (compressed) {
-        cnt = 1;
-        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &sz, &cnt, PRTE_SIZE))) {
+    if (0 < nholes) {
+        holes = (int32_t*)malloc(nholes * sizeof(int32_t));
+        if (NULL == holes) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        cnt = nholes;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, holes, &cnt, PRTE_INT32))) {
             PRTE_ERROR_LOG(rc);
             goto cleanup;
         }
     }
 
-    /* unpack the nodename object */
+    /* unpack how the node names were encoded */
     cnt = 1;
-    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &boptr, &cnt, PRTE_BYTE_OBJECT))) {
+    if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &u8, &cnt, PRTE_UINT8))) {
         PRTE_ERROR_LOG(rc);
         goto cleanup;
     }
+    if (PRTE_NIDMAP_NAMES_RANGES == u8) {
+        if (PRTE_SUCCESS != (rc = nidmap_decode_ranges(buf, &ranges, &nranges))) {
+            goto cleanup;
+        }
+    } else {
+        /* unpack compression flag for node names */
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &compressed, &cnt, PRTE_BOOL))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
 
-    /* if compressed, decompress */
-    if (compressed) {
-        if (!prte_compress.decompress_block((uint8_t**)&raw, sz,
-                                            boptr->bytes, boptr->size)) {
-            PRTE_ERROR_LOG(PRTE_ERROR);
-            if (NULL != boptr->bytes) {
-                free(boptr->bytes);
+        /* if compressed, get the uncompressed size */
+        if (compressed) {
+            cnt = 1;
+            if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &sz, &cnt, PRTE_SIZE))) {
+                PRTE_ERROR_LOG(rc);
+                goto cleanup;
             }
-            free(boptr);
-            rc = PRTE_ERROR;
+        }
+
+        /* unpack the nodename object */
+        cnt = 1;
+        if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &boptr, &cnt, PRTE_BYTE_OBJECT))) {
+            PRTE_ERROR_LOG(rc);
             goto cleanup;
         }
-    } else {
-        raw = (char*)boptr->bytes;
-        boptr->bytes = NULL;
-        boptr->size = 0;
-    }
-    if (NULL != boptr->bytes) {
-        free(boptr->bytes);
+
+        /* if compressed, decompress */
+        if (compressed) {
+            if (!prte_compress.decompress_block((uint8_t**)&raw, sz,
+                                                boptr->bytes, boptr->size)) {
+                PRTE_ERROR_LOG(PRTE_ERROR);
+                if (NULL != boptr->bytes) {
+                    free(boptr->bytes);
+                }
+                free(boptr);
+                rc = PRTE_ERROR;
+                goto cleanup;
+            }
+        } else {
+            raw = (char*)boptr->bytes;
+            boptr->bytes = NULL;
+            boptr->size = 0;
+        }
+        if (NULL != boptr->bytes) {
+            free(boptr->bytes);
+        }
+        free(boptr);
+        names = prte_argv_split(raw, ',');
+        free(raw);
     }
-    free(boptr);
-    names = prte_argv_split(raw, ',');
-    free(raw);
 
 
     /* unpack compression flag for daemon vpids */
@@ -378,61 +1025,47 @@ int prte_util_decode_nidmap(prte_buffer_t *buf)
     daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->jobid);
 
     /* get our topology */
-    for (n=0; n < prte_node_topologies->size; n++) {
-        if (NULL != (t = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, n))) {
-            break;
-        }
-    }
-    if (NULL == t) {
+    if (NULL == (t = nidmap_topology())) {
         /* should never happen */
         PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
         rc = PRTE_ERR_NOT_FOUND;
         goto cleanup;
     }
     /* create the node pool array - this will include
-     * _all_ nodes known to the allocation */
-    for (n=0; NULL != names[n]; n++) {
-        /* add this name to the pool */
-        nd = PRTE_NEW(prte_node_t);
-        nd->name = strdup(names[n]);
-        nd->index = n;
-        prte_pointer_array_set_item(prte_node_pool, n, nd);
-        /* see if this is our node */
-        if (prte_check_host_is_local(names[n])) {
-            /* add our aliases as an attribute - will include all the interface aliases captured in prte_init */
-            raw = prte_argv_join(prte_process_info.aliases, ',');
-            prte_set_attribute(&nd->attributes, PRTE_NODE_ALIAS, PRTE_ATTR_LOCAL, raw, PRTE_STRING);
-            free(raw);
-        }
-        /* set the topology - always default to homogeneous
-         * as that is the most common scenario */
-        nd->topology = t;
-        /* see if it has a daemon on it */
-        if (1 == nbytes && UINT8_MAX != vp8[n]) {
-            vpid = vp8[n];
-        } else if (2 == nbytes && UINT16_MAX != vp16[n]) {
-            vpid = vp16[n];
-        } else if (4 == nbytes && UINT32_MAX != vp32[n]) {
-            vpid = vp32[n];
-        } else {
-            vpid = UINT32_MAX;
-        }
-        if (UINT32_MAX != vpid) {
-            if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(daemons->procs, vpid))) {
-                proc = PRTE_NEW(prte_proc_t);
-                proc->name.jobid = PRTE_PROC_MY_NAME->jobid;
-                proc->name.vpid = vpid;
-                proc->state = PRTE_PROC_STATE_RUNNING;
-                PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
-                daemons->num_procs++;
-                prte_pointer_array_set_item(daemons->procs, proc->name.vpid, proc);
+     * _all_ nodes known to the allocation. If we already
+     * have a map, then this is a resync and we reuse the
+     * nodes we already know about */
+    n = 0;
+    h = 0;
+    index = 0;
+    if (NULL != ranges) {
+        /* generate the names directly from the ranges */
+        for (r=0; r < nranges; r++) {
+            rng = &ranges[r];
+            for (k=0; k < rng->count; k++, n++, index++) {
+                index = nidmap_skip_holes(holes, nholes, &h, index);
+                vpid = nidmap_vpid(nbytes, vp8, vp16, vp32, n);
+                if (PRTE_NIDMAP_NO_NUMBER == rng->width) {
+                    nidmap_set_node(daemons, t, index, rng->prefix, vpid);
+                } else {
+                    snprintf(host, sizeof(host), "%s%0*u%s", rng->prefix,
+                             (int)rng->width, rng->start + k, rng->suffix);
+                    nidmap_set_node(daemons, t, index, host, vpid);
+                }
             }
-            PRTE_RETAIN(nd);
-            proc->node = nd;
-            PRTE_RETAIN(proc);
-            nd->daemon = proc;
+        }
+    } else {
+        for (n=0; NULL != names[n]; n++, index++) {
+            index = nidmap_skip_holes(holes, nholes, &h, index);
+            vpid = nidmap_vpid(nbytes, vp8, vp16, vp32, n);
+            nidmap_set_node(daemons, t, index, names[n], vpid);
         }
     }
+    /* drop anything beyond the end of the map */
+    for (; index < prte_node_pool->size; index++) {
+        nidmap_drop_node(index);
+    }
+    nidmap_epoch = epoch;
 
     /* update num procs */
     if (prte_process_info.num_daemons != daemons->num_procs) {
@@ -442,6 +1075,9 @@ int prte_util_decode_nidmap(prte_buffer_t *buf)
     prte_routed.update_routing_plan();
 
   cleanup:
+    if (NULL != holes) {
+        free(holes);
+    }
     if (NULL != vp8) {
         free(vp8);
     }
@@ -451,12 +1087,104 @@ int prte_util_decode_nidmap(prte_buffer_t *buf)
     if (NULL != vp32) {
         free(vp32);
     }
+    if (NULL != ranges) {
+        nidmap_free_ranges(ranges, nranges);
+    }
     if (NULL != names) {
         prte_argv_free(names);
     }
     return rc;
 }
 
+void prte_util_nidmap_record(prte_node_t *node, uint8_t op)
+{
+    prte_nidmap_record_t *rec;
+
+    /* only the HNP tracks changes */
+    if (!PRTE_PROC_IS_MASTER) {
+        return;
+    }
+    if (!nidmap_log_init) {
+        PRTE_CONSTRUCT(&nidmap_log, prte_list_t);
+        nidmap_log_init = true;
+    }
+    rec = PRTE_NEW(prte_nidmap_record_t);
+    rec->op = op;
+    rec->index = node->index;
+    prte_list_append(&nidmap_log, &rec->super);
+    ++nidmap_epoch;
+}
+
+void prte_util_nidmap_remove_node(prte_node_t *node)
+{
+    nidmap_drop_node(node->index);
+}
+
+void prte_util_nidmap_clear_log(void)
+{
+    if (nidmap_log_init) {
+        PRTE_LIST_DESTRUCT(&nidmap_log);
+        nidmap_log_init = false;
+    }
+    nidmap_sent_epoch = nidmap_epoch;
+}
+
+int prte_util_nidmap_send_update(void)
+{
+    prte_buffer_t *buf;
+    prte_daemon_cmd_flag_t command = PRTE_DAEMON_NIDMAP_UPDATE_CMD;
+    prte_grpcomm_signature_t *sig;
+    int rc;
+
+    if (!PRTE_PROC_IS_MASTER || nidmap_sent_epoch == nidmap_epoch) {
+        /* nothing has changed */
+        return PRTE_SUCCESS;
+    }
+    if (prte_do_not_launch || 1 >= prte_process_info.num_daemons) {
+        /* nobody to tell */
+        prte_util_nidmap_clear_log();
+        return PRTE_SUCCESS;
+    }
+
+    buf = PRTE_NEW(prte_buffer_t);
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(buf, &command, 1, PRTE_DAEMON_CMD))) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(buf);
+        return rc;
+    }
+    /* send a full snapshot periodically so that any daemon that
+     * missed an update gets back in sync, or if so much has
+     * changed that a snapshot is the smaller message */
+    ++nidmap_nupdates;
+    if (0 >= prte_nidmap_snapshot_interval ||
+        0 == (nidmap_nupdates % prte_nidmap_snapshot_interval) ||
+        (int)prte_list_get_size(&nidmap_log) > prte_node_pool->size / 2) {
+        rc = prte_util_nidmap_create(prte_node_pool, buf);
+    } else {
+        rc = nidmap_create_delta(buf);
+    }
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PRTE_RELEASE(buf);
+        return rc;
+    }
+
+    /* goes to all daemons */
+    sig = PRTE_NEW(prte_grpcomm_signature_t);
+    sig->signature = (prte_process_name_t*)malloc(sizeof(prte_process_name_t));
+    sig->signature[0].jobid = PRTE_PROC_MY_NAME->jobid;
+    sig->signature[0].vpid = PRTE_VPID_WILDCARD;
+    sig->sz = 1;
+    if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_DAEMON, buf))) {
+        PRTE_ERROR_LOG(rc);
+    }
+    PRTE_RELEASE(buf);
+    PRTE_RELEASE(sig);
+
+    prte_util_nidmap_clear_log();
+    return rc;
+}
+
 int prte_util_pass_node_info(prte_buffer_t *buffer)
 {
     uint16_t *slots=NULL, slot = UINT16_MAX;
@@ -1058,19 +1786,59 @@ int prte_util_parse_node_info(prte_buffer_t *buf)
 }
 
 
+/* number of procs from the given app on a node - use the
+ * counts maintained by the mapper if we have them */
+static uint16_t nidmap_node_ppn(prte_job_t *jdata, prte_node_t *nptr,
+                                prte_app_idx_t idx)
+{
+    prte_job_map_t *map = jdata->map;
+    prte_proc_t *proc;
+    uint16_t ppn = 0;
+    int k;
+
+    if (NULL != map->ppn) {
+        if (nptr->index < map->ppn_stride) {
+            ppn = map->ppn[idx * map->ppn_stride + nptr->index];
+        }
+        return ppn;
+    }
+    for (k=0; k < nptr->procs->size; k++) {
+        if (NULL != (proc = (prte_proc_t*)prte_pointer_array_get_item(nptr->procs, k))) {
+            if (proc->name.jobid == jdata->jobid &&
+                proc->app_idx == idx) {
+                ++ppn;
+            }
+        }
+    }
+    return ppn;
+}
+
+static int nidmap_pack_ppn_run(prte_buffer_t *bucket, int32_t first,
+                               int32_t nnodes, uint16_t ppn)
+{
+    int rc;
+
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(bucket, &first, 1, PRTE_INT32))) {
+        return rc;
+    }
+    if (PRTE_SUCCESS != (rc = prte_dss.pack(bucket, &nnodes, 1, PRTE_INT32))) {
+        return rc;
+    }
+    return prte_dss.pack(bucket, &ppn, 1, PRTE_UINT16);
+}
+
 int prte_util_generate_ppn(prte_job_t *jdata,
                            prte_buffer_t *buf)
 {
-    uint16_t ppn;
+    uint16_t ppn, rppn;
     uint8_t *bytes;
-    int32_t nbytes;
+    int32_t nbytes, first, nnodes;
     int rc = PRTE_SUCCESS;
     prte_app_idx_t i;
-    int j, k;
+    int j;
     prte_byte_object_t bo, *boptr;
     bool compressed;
     prte_node_t *nptr;
-    prte_proc_t *proc;
     size_t sz;
     prte_buffer_t bucket;
     prte_app_context_t *app;
@@ -1080,6 +1848,11 @@ int prte_util_generate_ppn(prte_job_t *jdata,
     for (i=0; i < jdata->num_apps; i++) {
         /* for each app_context */
         if (NULL != (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            /* describe the ppn as runs of consecutive nodes that
+             * all have the same number of procs */
+            first = -1;
+            nnodes = 0;
+            rppn = 0;
             for (j=0; j < jdata->map->num_nodes; j++) {
                 if (NULL == (nptr = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, j))) {
                     continue;
@@ -1088,23 +1861,24 @@ int prte_util_generate_ppn(prte_job_t *jdata,
                 if (NULL == nptr->daemon) {
                     continue;
                 }
-                ppn = 0;
-                for (k=0; k < nptr->procs->size; k++) {
-                    if (NULL != (proc = (prte_proc_t*)prte_pointer_array_get_item(nptr->procs, k))) {
-                        if (proc->name.jobid == jdata->jobid &&
-                            proc->app_idx == app->idx) {
-                            ++ppn;
-                        }
-                    }
+                if (0 == (ppn = nidmap_node_ppn(jdata, nptr, app->idx))) {
+                    continue;
                 }
-                if (0 < ppn) {
-                    if (PRTE_SUCCESS != (rc = prte_dss.pack(&bucket, &nptr->index, 1, PRTE_INT32))) {
-                        goto cleanup;
-                    }
-                    if (PRTE_SUCCESS != (rc = prte_dss.pack(&bucket, &ppn, 1, PRTE_UINT16))) {
-                        goto cleanup;
-                    }
+                if (0 < nnodes && ppn == rppn && nptr->index == first + nnodes) {
+                    ++nnodes;
+                    continue;
                 }
+                if (0 < nnodes &&
+                    PRTE_SUCCESS != (rc = nidmap_pack_ppn_run(&bucket, first, nnodes, rppn))) {
+                    goto cleanup;
+                }
+                first = nptr->index;
+                nnodes = 1;
+                rppn = ppn;
+            }
+            if (0 < nnodes &&
+                PRTE_SUCCESS != (rc = nidmap_pack_ppn_run(&bucket, first, nnodes, rppn))) {
+                goto cleanup;
             }
         }
         prte_dss.unload(&bucket, (void**)&bytes, &nbytes);
@@ -1151,7 +1925,7 @@ int prte_util_generate_ppn(prte_job_t *jdata,
 int prte_util_decode_ppn(prte_job_t *jdata,
                          prte_buffer_t *buf)
 {
-    int32_t index;
+    int32_t index, nnodes, j;
     prte_app_idx_t n;
     int cnt, rc=PRTE_SUCCESS, m;
     prte_byte_object_t *boptr;
@@ -1170,11 +1944,17 @@ int prte_util_decode_ppn(prte_job_t *jdata,
         }
     }
 
+    /* we are about to create a proc object for every rank in the job */
+    if (!PRTE_PROC_IS_MASTER) {
+        prte_proc_slab_reserve(jdata->num_procs);
+    }
+
     for (n=0; n < jdata->num_apps; n++) {
         /* unpack the compression flag */
         cnt = 1;
         if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &compressed, &cnt, PRTE_BOOL))) {
             PRTE_ERROR_LOG(rc);
+            prte_proc_slab_retire();
             return rc;
         }
         /* if compressed, unpack the raw size */
@@ -1182,6 +1962,7 @@ int prte_util_decode_ppn(prte_job_t *jdata,
             cnt = 1;
             if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &sz, &cnt, PRTE_SIZE))) {
                 PRTE_ERROR_LOG(rc);
+                prte_proc_slab_retire();
                 return rc;
             }
         }
@@ -1189,6 +1970,7 @@ int prte_util_decode_ppn(prte_job_t *jdata,
         cnt = 1;
         if (PRTE_SUCCESS != (rc = prte_dss.unpack(buf, &boptr, &cnt, PRTE_BYTE_OBJECT))) {
             PRTE_ERROR_LOG(rc);
+            prte_proc_slab_retire();
             return rc;
         }
 
@@ -1205,6 +1987,7 @@ int prte_util_decode_ppn(prte_job_t *jdata,
                                                 boptr->bytes, boptr->size)) {
                 PRTE_ERROR_LOG(PRTE_ERROR);
                 PRTE_RELEASE(boptr);
+                prte_proc_slab_retire();
                 return PRTE_ERROR;
             }
         } else {
@@ -1222,43 +2005,56 @@ int prte_util_decode_ppn(prte_job_t *jdata,
         PRTE_CONSTRUCT(&bucket, prte_buffer_t);
         prte_dss.load(&bucket, bytes, sz);
 
-        /* unpack each node and its ppn */
+        /* unpack each run of nodes and their ppn */
         cnt = 1;
         while (PRTE_SUCCESS == (rc = prte_dss.unpack(&bucket, &index, &cnt, PRTE_INT32))) {
-            /* get the corresponding node object */
-            if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, index))) {
-                rc = PRTE_ERR_NOT_FOUND;
+            cnt = 1;
+            if (PRTE_SUCCESS != (rc = prte_dss.unpack(&bucket, &nnodes, &cnt, PRTE_INT32))) {
                 PRTE_ERROR_LOG(rc);
                 goto error;
             }
-            /* add the node to the job map if not already assigned */
-            if (!PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_MAPPED)) {
-                PRTE_RETAIN(node);
-                prte_pointer_array_add(jdata->map->nodes, node);
-                PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
-            }
-            /* get the ppn */
             cnt = 1;
             if (PRTE_SUCCESS != (rc = prte_dss.unpack(&bucket, &ppn, &cnt, PRTE_UINT16))) {
                 PRTE_ERROR_LOG(rc);
                 goto error;
             }
-            /* create a proc object for each one */
-            for (k=0; k < ppn; k++) {
-                proc = PRTE_NEW(prte_proc_t);
-                proc->name.jobid = jdata->jobid;
-                /* leave the vpid undefined as this will be determined
-                 * later when we do the overall ranking */
-                proc->app_idx = n;
-                proc->parent = node->daemon->name.vpid;
-                PRTE_RETAIN(node);
-                proc->node = node;
-                /* flag the proc as ready for launch */
-                proc->state = PRTE_PROC_STATE_INIT;
-                prte_pointer_array_add(node->procs, proc);
-                node->num_procs++;
-                /* we will add the proc to the jdata array when we
-                 * compute its rank */
+            for (j=0; j < nnodes; j++) {
+                /* get the corresponding node object */
+                if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, index + j))) {
+                    rc = PRTE_ERR_NOT_FOUND;
+                    PRTE_ERROR_LOG(rc);
+                    goto error;
+                }
+                /* add the node to the job map if not already assigned */
+                if (!PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_MAPPED)) {
+                    PRTE_RETAIN(node);
+                    prte_pointer_array_add(jdata->map->nodes, node);
+                    PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
+                }
+                /* make room for all the new procs at once */
+                m = node->procs->size - node->procs->number_free + ppn;
+                if (m > node->procs->size &&
+                    PRTE_SUCCESS != (rc = prte_pointer_array_set_size(node->procs, m))) {
+                    PRTE_ERROR_LOG(rc);
+                    goto error;
+                }
+                /* create a proc object for each one */
+                for (k=0; k < ppn; k++) {
+                    proc = PRTE_NEW(prte_proc_t);
+                    proc->name.jobid = jdata->jobid;
+                    /* leave the vpid undefined as this will be determined
+                     * later when we do the overall ranking */
+                    proc->app_idx = n;
+                    proc->parent = node->daemon->name.vpid;
+                    PRTE_RETAIN(node);
+                    proc->node = node;
+                    /* flag the proc as ready for launch */
+                    proc->state = PRTE_PROC_STATE_INIT;
+                    prte_pointer_array_add(node->procs, proc);
+                    /* we will add the proc to the jdata array when we
+                     * compute its rank */
+                }
+                node->num_procs += ppn;
             }
             cnt = 1;
         }
@@ -1267,6 +2063,7 @@ int prte_util_decode_ppn(prte_job_t *jdata,
     if (PRTE_SUCCESS != rc && PRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
         PRTE_ERROR_LOG(rc);
     }
+    prte_proc_slab_retire();
 
     /* reset any flags */
     for (m=0; m < jdata->map->nodes->size; m++) {
@@ -1279,6 +2076,7 @@ int prte_util_decode_ppn(prte_job_t *jdata,
 
   error:
     PRTE_DESTRUCT(&bucket);
+    prte_proc_slab_retire();
     /* reset any flags */
     for (m=0; m < jdata->map->nodes->size; m++) {
         node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, m);
@@ -35,6 +35,26 @@ PRTE_EXPORT int prte_util_nidmap_create(prte_pointer_array_t *pool,
 
 PRTE_EXPORT int prte_util_decode_nidmap(prte_buffer_t *buf);
 
+/* incremental updates to the nidmap - the HNP records changes
+ * to the node pool as they occur, and periodically broadcasts
+ * them to the daemons as a delta against the epoch they last
+ * saw. A full snapshot is sent instead every
+ * prte_nidmap_snapshot_interval updates so that any daemon
+ * that fell out of sync can recover */
+#define PRTE_NIDMAP_ADD     1   // node was added to the pool
+#define PRTE_NIDMAP_REMOVE  2   // node was removed from the pool
+#define PRTE_NIDMAP_UPDATE  3   // node state or daemon assignment changed
+
+PRTE_EXPORT void prte_util_nidmap_record(prte_node_t *node, uint8_t op);
+
+/* take a node out of the pool - nodes must leave the pool
+ * this way so the daemons are told of it */
+PRTE_EXPORT void prte_util_nidmap_remove_node(prte_node_t *node);
+
+PRTE_EXPORT int prte_util_nidmap_send_update(void);
+
+PRTE_EXPORT void prte_util_nidmap_clear_log(void);
+
 
 /* pass topology and #slots info */
 PRTE_EXPORT int prte_util_pass_node_info(prte_buffer_t *buf);